@@ -0,0 +1,136 @@
+#pragma once
+/*
+FixedString<Capacity>: a string stored entirely inside the object, usable at compile time.
+
+String("literal") runs strlen at runtime and, for long literals, allocates. A FixedString is built in a constant
+expression instead: its characters live in an inline array sized at compile time, so there is no heap storage and
+no runtime work at all for strings known while compiling.
+
+    constexpr FixedString method = "GET";                  // FixedString<3>, deduced from the literal
+    static_assert(method == "GET" && method.size() == 3);
+    FixedString<15> host;                                   // capacity 15, built at runtime with append()
+
+Because every member is public and the type has no pointers, it is a structural type and can be used as a
+non-type template parameter (C++20):
+
+    template <FixedString Name> struct Metric { static constexpr StringView name = Name.view(); };
+    Metric<"http.requests"> requests;
+
+Conversions:
+    - view() / StringView: free, points at the characters inside the FixedString,
+    - toString(): one copy with the length already known (no strlen); inline when it fits in String's SSO buffer.
+Appending past the capacity is a compile error in a constant expression and is truncated at runtime.
+*/
+#include "StringClass.hpp"
+#include "StringView.hpp"
+#include "../myStrLen.hpp"
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+
+template <size_t Capacity>
+struct FixedString {
+    // Public so that FixedString is a structural type (required for template parameters); use the accessors.
+    char chars[Capacity + 1] = {}; // always null-terminated
+    size_t length = 0;
+
+    constexpr FixedString() = default;
+
+    // From a string literal: FixedString<N - 1> is deduced by the guide below
+    constexpr FixedString(const char (&literal)[Capacity + 1]){
+        append(StringView(literal, Capacity));
+    }
+
+    // From any text that fits (longer text is truncated to Capacity)
+    constexpr explicit FixedString(StringView text){
+        append(text);
+    }
+
+    static constexpr size_t capacity(){ return Capacity; }
+    constexpr size_t size() const { return length; }
+    constexpr bool empty() const { return length == 0; }
+    constexpr const char* data() const { return chars; }
+    constexpr const char* c_str() const { return chars; }
+    constexpr char operator[](size_t index) const { return chars[index]; }
+    constexpr const char* begin() const { return chars; }
+    constexpr const char* end() const { return chars + length; }
+
+    constexpr StringView view() const { return StringView(chars, length); }
+    constexpr operator StringView() const { return view(); }
+    String toString(std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const {
+        return String(view(), resource);
+    }
+
+    constexpr FixedString& append(StringView text){
+        size_t room = Capacity - length;
+        size_t count = text.size() < room ? text.size() : room;
+        for(size_t i = 0; i < count; i++){
+            chars[length + i] = text[i];
+        }
+        length += count;
+        chars[length] = '\0';
+        return *this;
+    }
+    constexpr FixedString& append(char c){
+        if(length < Capacity){
+            chars[length++] = c;
+            chars[length] = '\0';
+        }
+        return *this;
+    }
+    constexpr void clear(){
+        length = 0;
+        chars[0] = '\0';
+    }
+};
+
+template <size_t N>
+FixedString(const char (&)[N]) -> FixedString<N - 1>;
+
+// A FixedString whose capacity is chosen up front and whose content is built at runtime (same type, clearer name)
+template <size_t Capacity>
+using InlineString = FixedString<Capacity>;
+
+// Comparisons work across capacities and against anything convertible to StringView
+template <size_t A, size_t B>
+constexpr bool operator==(const FixedString<A> &lhs, const FixedString<B> &rhs){ return lhs.view() == rhs.view(); }
+template <size_t A>
+constexpr bool operator==(const FixedString<A> &lhs, StringView rhs){ return lhs.view() == rhs; }
+template <size_t A, size_t B>
+constexpr std::strong_ordering operator<=>(const FixedString<A> &lhs, const FixedString<B> &rhs){ return lhs.view().compare(rhs.view()) <=> 0; }
+template <size_t A>
+constexpr std::strong_ordering operator<=>(const FixedString<A> &lhs, StringView rhs){ return lhs.view().compare(rhs) <=> 0; }
+
+// Concatenation at compile time: the result capacity is the sum of both capacities
+template <size_t A, size_t B>
+constexpr FixedString<A + B> operator+(const FixedString<A> &lhs, const FixedString<B> &rhs){
+    FixedString<A + B> result;
+    result.append(lhs.view()).append(rhs.view());
+    return result;
+}
+
+/*
+"GET"_fs is a FixedString<3>, so literals can be passed where a FixedString is expected without spelling the type.
+*/
+template <FixedString Literal>
+constexpr auto operator""_fs(){
+    return Literal;
+}
+
+/*
+FNV-1a over the bytes, computable at compile time (myHash is faster at runtime but not constexpr).
+Switch-on-string dispatch hashes the input once and switches on constants; the matched case must still compare the
+text, since two strings can share a hash:
+    switch(fixedHash(method)){
+        case fixedHash("GET"): if(method == "GET") ...; break;
+    }
+A duplicate case label then means a compile-time collision, so the table is checked by the compiler.
+*/
+constexpr uint64_t fixedHash(StringView text){
+    uint64_t hash = 14695981039346656037ULL;
+    for(char c : text){
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
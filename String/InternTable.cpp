@@ -0,0 +1,125 @@
+#include "InternTable.hpp"
+#include "../myHash.hpp"
+#include "../myMemOps.hpp"
+#include <cstring>
+
+static constexpr size_t initialSlotCount = 64;
+
+InternTable::Slots::Slots(size_t capacity)
+    : capacity(capacity), entries(new std::atomic<const InternEntry*>[capacity]) {
+    for(size_t i = 0; i < capacity; i++){
+        entries[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+InternTable::InternTable() : shards(new Shard[shardCount]) {
+    for(size_t i = 0; i < shardCount; i++){
+        shards[i].allSlots.emplace_back(new Slots(initialSlotCount));
+        shards[i].slots.store(shards[i].allSlots.back().get(), std::memory_order_release);
+    }
+}
+
+InternTable::~InternTable() = default; // Arenas and slot arrays are released with the shards
+
+/*
+Linear probing. The hash is compared before the characters, so a probe over a different string almost never touches
+its characters. The acquire load pairs with the release store in insertSlot: once a reader sees an entry pointer,
+it also sees the entry's fully written header and characters.
+*/
+const InternEntry* InternTable::probe(const Slots* slots, uint64_t hash, const char* str, size_t len){
+    size_t mask = slots->capacity - 1;
+    for(size_t i = hash & mask;; i = (i + 1) & mask){
+        const InternEntry* entry = slots->entries[i].load(std::memory_order_acquire);
+        if(!entry){
+            return nullptr;
+        }
+        if(entry->hash == hash && entry->length == len && myMemCmp(entry->chars(), str, len) == 0){
+            return entry;
+        }
+    }
+}
+
+void InternTable::insertSlot(const Slots* slots, const InternEntry* entry){
+    size_t mask = slots->capacity - 1;
+    for(size_t i = entry->hash & mask;; i = (i + 1) & mask){
+        if(!slots->entries[i].load(std::memory_order_relaxed)){
+            slots->entries[i].store(entry, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+InternedString InternTable::find(const char* str, size_t len) const {
+    uint64_t hash = myHash(str, len);
+    const Shard& shard = shardFor(hash);
+    return InternedString(probe(shard.slots.load(std::memory_order_acquire), hash, str, len));
+}
+
+InternedString InternTable::intern(const char* str, size_t len){
+    return internHashed(str, len, myHash(str, len));
+}
+
+InternedString InternTable::internHashed(const char* str, size_t len, uint64_t hash){
+    Shard& shard = shardFor(hash);
+    // Fast path: no lock, the common case once the working set of names has been interned
+    if(const InternEntry* entry = probe(shard.slots.load(std::memory_order_acquire), hash, str, len)){
+        return InternedString(entry);
+    }
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const Slots* slots = shard.slots.load(std::memory_order_relaxed);
+    if(const InternEntry* entry = probe(slots, hash, str, len)){
+        return InternedString(entry); // Another thread inserted it while we waited for the lock
+    }
+
+    // Header and characters in one arena block; the arena memory never moves or gets freed before the table
+    void* block = shard.arena.allocate(sizeof(InternEntry) + len + 1, alignof(InternEntry));
+    InternEntry* entry = static_cast<InternEntry*>(block);
+    entry->hash = hash;
+    entry->length = len;
+    entry->id = nextId.fetch_add(1, std::memory_order_relaxed);
+    char* chars = reinterpret_cast<char*>(entry + 1);
+    std::memcpy(chars, str, len);
+    chars[len] = '\0';
+
+    // Keep the load factor at or below 1/2 so probe sequences stay short
+    if((shard.count + 1) * 2 > slots->capacity){
+        Slots* grown = new Slots(slots->capacity * 2);
+        shard.allSlots.emplace_back(grown);
+        for(size_t i = 0; i < slots->capacity; i++){
+            if(const InternEntry* existing = slots->entries[i].load(std::memory_order_relaxed)){
+                insertSlot(grown, existing);
+            }
+        }
+        shard.slots.store(grown, std::memory_order_release); // Old array stays alive for readers still using it
+        slots = grown;
+    }
+    insertSlot(slots, entry);
+    shard.count++;
+    return InternedString(entry);
+}
+
+InternedString InternTable::intern(const char* str){
+    return str ? intern(str, std::strlen(str)) : intern("", 0);
+}
+
+InternedString InternTable::intern(const String& str){
+    return internHashed(str.c_str(), str.getLength(), str.hash()); // A String that was interned before has its hash cached
+}
+
+size_t InternTable::size() const {
+    return nextId.load(std::memory_order_relaxed);
+}
+
+InternTable& globalInternTable(){
+    static InternTable table;
+    return table;
+}
+
+InternedString intern(const char* str){
+    return globalInternTable().intern(str);
+}
+
+InternedString intern(const String& str){
+    return globalInternTable().intern(str);
+}
@@ -0,0 +1,107 @@
+#pragma once
+/*
+String interning.
+
+Interning stores ONE canonical copy of every distinct string and hands out a handle to it:
+    InternedString a = intern("http.requests.total");
+    InternedString b = intern(someString);
+    if(a == b) ...   // pointer compare, O(1), no matter how long the strings are
+Two handles are equal exactly when their strings are equal, so code that compares the same few thousand names
+millions of times pays for the characters once (at intern time) instead of on every comparison.
+
+Concurrency design:
+    - The table is split into shards by hash, each with its own mutex, so inserts on different shards never contend.
+    - Lookups never lock. Each shard publishes an open-addressing slot array through an atomic pointer; a slot goes
+      from empty to an entry exactly once and never changes again, so a reader can probe it with acquire loads.
+    - When a shard grows, the new slot array is published atomically and the old one is kept (retired) until the table
+      is destroyed, so a reader still probing the old array never touches freed memory. A reader that misses a
+      concurrent insert just falls through to the locked insert path, which re-checks.
+    - Interned characters live in a per-shard ArenaResource that is never reset: their addresses are stable for the
+      lifetime of the table, so handles and c_str() pointers never dangle.
+*/
+#include "StringClass.hpp"
+#include "../memoryResources.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// One canonical string. Allocated once in a shard arena, immutable afterwards.
+struct InternEntry {
+    uint64_t hash;
+    size_t length;
+    uint32_t id;      // dense id in insertion order within its table, handy for arrays indexed by name
+    const char* chars() const { return reinterpret_cast<const char*>(this + 1); } // characters follow the header
+};
+
+// Compact handle to an interned string: one pointer, compared by address
+class InternedString {
+    public:
+        InternedString() = default; // null handle, equal only to other null handles
+
+        const char* c_str() const { return entry ? entry->chars() : ""; }
+        size_t getLength() const { return entry ? entry->length : 0; }
+        uint64_t hash() const { return entry ? entry->hash : 0; }
+        uint32_t id() const { return entry ? entry->id : UINT32_MAX; }
+        bool isNull() const { return entry == nullptr; }
+
+        bool operator==(const InternedString& other) const { return entry == other.entry; }
+        bool operator!=(const InternedString& other) const { return entry != other.entry; }
+
+    private:
+        explicit InternedString(const InternEntry* entry) : entry(entry) {}
+        const InternEntry* entry = nullptr;
+        friend class InternTable;
+};
+
+class InternTable {
+    public:
+        static constexpr size_t shardCount = 64;
+
+        InternTable();
+        ~InternTable();
+        InternTable(const InternTable&) = delete;
+        InternTable& operator=(const InternTable&) = delete;
+
+        // Returns the canonical handle, inserting the string on first use. Thread-safe.
+        InternedString intern(const char* str, size_t len);
+        InternedString intern(const char* str);
+        InternedString intern(const String& str);
+
+        // Lock-free lookup that never inserts: a null handle if the string was never interned
+        InternedString find(const char* str, size_t len) const;
+
+        // Number of distinct strings (approximate while other threads are inserting)
+        size_t size() const;
+
+    private:
+        struct Slots {
+            explicit Slots(size_t capacity);
+            size_t capacity; // power of two
+            std::unique_ptr<std::atomic<const InternEntry*>[]> entries;
+        };
+
+        // Padded to a cache line so the mutexes of neighbouring shards do not false-share
+        struct alignas(64) Shard {
+            std::atomic<const Slots*> slots{nullptr};
+            std::mutex mutex;                         // serializes inserts into this shard
+            size_t count = 0;                         // guarded by mutex
+            std::vector<std::unique_ptr<Slots>> allSlots; // current + retired arrays, freed with the table
+            ArenaResource arena;                      // interned characters, never reset
+        };
+
+        // hash must be myHash(str, len): the same function as String::hash()
+        InternedString internHashed(const char* str, size_t len, uint64_t hash);
+        static const InternEntry* probe(const Slots* slots, uint64_t hash, const char* str, size_t len);
+        static void insertSlot(const Slots* slots, const InternEntry* entry);
+        Shard& shardFor(uint64_t hash) const { return shards[(hash >> 58) & (shardCount - 1)]; }
+
+        std::unique_ptr<Shard[]> shards;
+        std::atomic<uint32_t> nextId{0};
+};
+
+// Process-wide table used by the free intern() functions
+InternTable& globalInternTable();
+InternedString intern(const char* str);
+InternedString intern(const String& str);
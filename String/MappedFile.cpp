@@ -0,0 +1,62 @@
+#include "MappedFile.hpp"
+#include <cerrno>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const char *path) : mapping(""), length(0) {
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if(fd < 0){
+        throw std::system_error(errno, std::generic_category(), std::string("open ") + path);
+    }
+    struct stat info;
+    if(::fstat(fd, &info) != 0){
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), std::string("fstat ") + path);
+    }
+    if(info.st_size == 0){
+        ::close(fd); // mmap rejects a zero length; an empty file is just an empty view
+        return;
+    }
+    size_t fileSize = static_cast<size_t>(info.st_size);
+    void *address = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    int error = errno;
+    ::close(fd); // The mapping keeps its own reference to the file
+    if(address == MAP_FAILED){
+        throw std::system_error(error, std::generic_category(), std::string("mmap ") + path);
+    }
+    // Parsers scan front to back: ask for aggressive read-ahead and early reclaim of pages already passed
+    ::madvise(address, fileSize, MADV_SEQUENTIAL);
+    mapping = static_cast<const char*>(address);
+    length = fileSize;
+}
+
+void MappedFile::unmap() noexcept {
+    if(length != 0){
+        ::munmap(const_cast<char*>(mapping), length);
+    }
+    mapping = "";
+    length = 0;
+}
+
+MappedFile::~MappedFile(){
+    unmap();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept : mapping(other.mapping), length(other.length) {
+    other.mapping = "";
+    other.length = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile &&other) noexcept {
+    if(this != &other){
+        unmap();
+        std::swap(mapping, other.mapping);
+        std::swap(length, other.length);
+    }
+    return *this;
+}
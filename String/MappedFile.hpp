@@ -0,0 +1,43 @@
+#pragma once
+/*
+Read-only memory-mapped file.
+
+Reading a file with read()/ifstream copies every byte from the page cache into a user buffer, and getline() copies it
+once more into a std::string. Mapping the file makes the page cache pages themselves visible in our address space:
+no read buffer, no copies, and the kernel pages data in (with read-ahead) as the parser touches it.
+Combined with StringView and LineRange, a multi-GB log can be parsed with no allocation per line:
+
+    MappedFile file("access.log");
+    for(StringView line : file.lines()){
+        StringView method = line.takeUntil(' ');
+        ...
+        String kept(method); // copy only what must outlive the mapping
+    }
+
+Every StringView obtained from the file dangles once the MappedFile is destroyed.
+Opening fails with std::system_error (carrying errno). An empty file is valid and yields an empty view.
+*/
+#include "StringView.hpp"
+
+class MappedFile {
+    public:
+        explicit MappedFile(const char *path);
+        ~MappedFile();
+
+        // Move-only: the mapping has exactly one owner
+        MappedFile(MappedFile &&other) noexcept;
+        MappedFile& operator=(MappedFile &&other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const char* data() const { return mapping; }
+        size_t size() const { return length; }
+        StringView view() const { return StringView(mapping, length); }
+        LineRange lines() const { return LineRange(view()); }
+
+    private:
+        void unmap() noexcept;
+
+        const char *mapping;
+        size_t length;
+};
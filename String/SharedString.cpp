@@ -0,0 +1,175 @@
+#include "SharedString.hpp"
+#include "../myHash.hpp"
+#include "../myMemCpy.hpp"
+#include <new>
+#include <utility>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+SharedStringBlock* SharedString::allocateBlock(size_t capacity, std::pmr::memory_resource *resource){
+    void *memory = resource->allocate(sizeof(SharedStringBlock) + capacity + 1, alignof(SharedStringBlock));
+    SharedStringBlock *block = new (memory) SharedStringBlock;
+    block->references.store(1, std::memory_order_relaxed);
+    block->hash.store(0, std::memory_order_relaxed);
+    block->length = 0;
+    block->capacity = capacity;
+    block->resource = resource;
+    block->chars()[0] = '\0';
+    return block;
+}
+
+void SharedString::destroy(SharedStringBlock *block) noexcept {
+    std::pmr::memory_resource *resource = block->resource;
+    size_t bytes = sizeof(SharedStringBlock) + block->capacity + 1;
+    block->~SharedStringBlock();
+    resource->deallocate(block, bytes, alignof(SharedStringBlock));
+}
+
+SharedString::SharedString(StringView view, std::pmr::memory_resource *resource){
+    if(view.empty()){
+        return;
+    }
+    block = allocateBlock(view.size(), resource);
+    myMemCpy(block->chars(), view.data(), view.size());
+    block->chars()[view.size()] = '\0';
+    block->length = view.size();
+}
+
+uint64_t SharedString::hash() const {
+    if(block == nullptr){
+        return myHash("", 0);
+    }
+    uint64_t value = block->hash.load(std::memory_order_relaxed);
+    if(value == 0){
+        value = myHash(block->chars(), block->length); // racing threads compute the same value
+        block->hash.store(value, std::memory_order_relaxed);
+    }
+    return value;
+}
+
+/*
+Copy-on-write: a unique block that is large enough is written in place. Otherwise the characters move to a new block
+(from the same resource), whose capacity at least doubles when growing so repeated appends stay amortized O(1), and
+the old block loses one reference: the other holders keep it unchanged.
+*/
+void SharedString::prepareWrite(size_t capacity){
+    if(block && capacity <= block->capacity && block->references.load(std::memory_order_acquire) == 1){
+        block->hash.store(0, std::memory_order_relaxed);
+        return;
+    }
+    std::pmr::memory_resource *resource = block ? block->resource : std::pmr::get_default_resource();
+    size_t length = getLength();
+    if(block && capacity > block->capacity && capacity < block->capacity * 2){
+        capacity = block->capacity * 2;
+    }
+    SharedStringBlock *fresh = allocateBlock(capacity, resource);
+    myMemCpy(fresh->chars(), c_str(), length + 1);
+    fresh->length = length;
+    release(block);
+    block = fresh;
+}
+
+SharedString& SharedString::append(StringView text){
+    if(text.empty()){
+        return *this;
+    }
+    size_t length = getLength();
+    // text may point into our own block, which prepareWrite frees when it has to reallocate a unique block
+    if(block && text.data() >= block->chars() && text.data() < block->chars() + block->length && length + text.size() > block->capacity){
+        String copy(text);
+        return append(copy.view());
+    }
+    prepareWrite(length + text.size());
+    myMemCpy(block->chars() + length, text.data(), text.size());
+    block->length = length + text.size();
+    block->chars()[block->length] = '\0';
+    return *this;
+}
+
+SharedString& SharedString::assign(StringView text){
+    if(text.empty()){
+        clear();
+        return *this;
+    }
+    if(block && text.data() >= block->chars() && text.data() <= block->chars() + block->length){
+        String copy(text); // assigning a slice of ourselves
+        return assign(copy.view());
+    }
+    if(block && text.size() <= block->capacity && block->references.load(std::memory_order_acquire) == 1){
+        block->hash.store(0, std::memory_order_relaxed);
+    }
+    else{
+        // Nothing to preserve: a fresh block without copying the old characters
+        SharedStringBlock *fresh = allocateBlock(text.size(), block ? block->resource : std::pmr::get_default_resource());
+        release(block);
+        block = fresh;
+    }
+    myMemCpy(block->chars(), text.data(), text.size());
+    block->length = text.size();
+    block->chars()[block->length] = '\0';
+    return *this;
+}
+
+char* SharedString::mutableData(){
+    if(block == nullptr){
+        return const_cast<char*>(c_str()); // empty: nothing to write
+    }
+    prepareWrite(block->length);
+    return block->chars();
+}
+
+uintptr_t AtomicSharedString::lock() const {
+    while(true){
+        uintptr_t previous = word.fetch_or(1, std::memory_order_acquire);
+        if((previous & 1) == 0){
+            return previous;
+        }
+        while(word.load(std::memory_order_relaxed) & 1){
+#if defined(__x86_64__) || defined(__i386__)
+            _mm_pause();
+#endif
+        }
+    }
+}
+
+SharedString AtomicSharedString::load() const {
+    uintptr_t current = lock();
+    SharedString::retain(pointer(current));
+    unlock(current);
+    return SharedString(pointer(current));
+}
+
+SharedString AtomicSharedString::exchange(SharedString value){
+    uintptr_t desired = reinterpret_cast<uintptr_t>(value.block);
+    value.block = nullptr;
+    uintptr_t previous = lock();
+    unlock(desired);
+    return SharedString(pointer(previous)); // the caller's copy releases it outside the lock
+}
+
+bool AtomicSharedString::compareExchange(SharedString &expected, SharedString desired){
+    uintptr_t current = lock();
+    if(pointer(current) == expected.block){
+        unlock(reinterpret_cast<uintptr_t>(desired.block));
+        desired.block = nullptr;
+        SharedString previous(pointer(current)); // drops the slot's reference to the old value
+        return true;
+    }
+    SharedString::retain(pointer(current));
+    unlock(current);
+    expected = SharedString(pointer(current));
+    return false;
+}
+
+/*
+cached holds a reference to its block, so that block cannot be freed and its address cannot be reused by a new value:
+equal pointers really mean "unchanged", without the lock.
+*/
+bool AtomicSharedString::refresh(SharedString &cached) const {
+    if(pointer(word.load(std::memory_order_acquire)) == cached.block){
+        return false;
+    }
+    cached = load();
+    return true;
+}
@@ -0,0 +1,164 @@
+#pragma once
+/*
+Immutable, atomically reference-counted strings for handing one payload to many threads.
+
+Copying a String copies its characters (one allocation + memcpy per copy), which is the right default for a value
+type but wasteful when the same request body or config blob is handed to 16 worker threads that only read it.
+A SharedString points at one heap block holding a reference count, the length, a cached hash and the characters:
+    SharedString payload(body);          // one allocation + copy, like a String
+    for(auto &worker : workers)
+        worker.post(payload);            // O(1) per copy: one atomic increment, no allocation
+Copy-on-write: append/assign/mutableData() write in place when this is the only reference and otherwise first copy
+the characters into a fresh block, so other holders never see a change.
+
+Conversions to and from String always copy: one allocation plus a copy of the characters, in both directions, even
+from an rvalue String. A String's heap block holds only the characters, while a shared block needs the header in
+front of them, so neither can adopt the other's allocation. Convert once, when the payload is handed out, and pass
+SharedStrings (or StringViews of them) from then on.
+
+The reference count uses the usual shared_ptr protocol: relaxed increments (a copy is made from a live reference, so
+the block cannot be freed meanwhile), acq_rel decrements so the last owner sees every write before freeing.
+As with shared_ptr, different SharedString objects sharing a block may be used from different threads freely, but one
+SharedString object must not be written by one thread while another reads it: use AtomicSharedString for that.
+*/
+#include "StringClass.hpp"
+#include <atomic>
+#include <compare>
+#include <cstdint>
+#include <memory_resource>
+
+// Header of a shared block; the null-terminated characters follow it in the same allocation
+struct SharedStringBlock {
+    std::atomic<size_t> references;
+    std::atomic<uint64_t> hash; // 0 = not computed yet
+    size_t length;
+    size_t capacity;            // characters that fit after the header, excluding the null-terminator
+    std::pmr::memory_resource *resource;
+    char* chars() { return reinterpret_cast<char*>(this + 1); }
+    const char* chars() const { return reinterpret_cast<const char*>(this + 1); }
+};
+
+class SharedString {
+    public:
+        SharedString() = default; // empty, no allocation
+        // One allocation from resource + copy of the characters (also for a String: see above)
+        explicit SharedString(StringView view, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+        explicit SharedString(const String &str, std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : SharedString(str.view(), resource) {}
+
+        SharedString(const SharedString &other) noexcept : block(other.block) { retain(block); }
+        SharedString(SharedString &&other) noexcept : block(other.block) { other.block = nullptr; }
+        SharedString& operator=(const SharedString &other) noexcept {
+            retain(other.block);     // before releasing ours: a self-assignment must not free the block
+            release(block);
+            block = other.block;
+            return *this;
+        }
+        SharedString& operator=(SharedString &&other) noexcept {
+            if(this != &other){
+                release(block);
+                block = other.block;
+                other.block = nullptr;
+            }
+            return *this;
+        }
+        ~SharedString() { release(block); }
+
+        const char* c_str() const { return block ? block->chars() : ""; }
+        size_t getLength() const { return block ? block->length : 0; }
+        bool empty() const { return getLength() == 0; }
+        StringView view() const { return StringView(c_str(), getLength()); }
+        operator StringView() const { return view(); }
+        char operator[](size_t index) const { return c_str()[index]; }
+
+        // Number of SharedStrings (including AtomicSharedStrings) holding this block; 0 when empty
+        size_t useCount() const { return block ? block->references.load(std::memory_order_relaxed) : 0; }
+        // true when the characters are not shared: mutation then happens in place
+        bool isUnique() const { return block == nullptr || block->references.load(std::memory_order_acquire) == 1; }
+
+        // myHash of the characters (equal to String::hash()), computed once per block and shared by all holders
+        uint64_t hash() const;
+
+        // A copy into a new String (one allocation unless it fits inline), even when this is the only reference
+        String toString(std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const { return String(view(), resource); }
+
+        /*
+        Copy-on-write mutation. A shared block is copied first (with geometric growth for append); the other holders
+        keep the old characters. mutableData() returns a writable pointer to getLength() characters, valid until the
+        next copy, mutation or destruction of this SharedString.
+        */
+        SharedString& append(StringView text);
+        SharedString& assign(StringView text);
+        char* mutableData();
+        void clear() { release(block); block = nullptr; }
+
+        void swap(SharedString &other) noexcept { std::swap(block, other.block); }
+
+        // Shared blocks compare equal without looking at the characters
+        bool operator==(const SharedString &other) const { return block == other.block || view() == other.view(); }
+        std::strong_ordering operator<=>(const SharedString &other) const { return view().compare(other.view()) <=> 0; }
+
+    private:
+        explicit SharedString(SharedStringBlock *block) noexcept : block(block) {} // adopts one reference
+
+        static void retain(SharedStringBlock *block) noexcept {
+            if(block){
+                block->references.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        static void release(SharedStringBlock *block) noexcept {
+            if(block && block->references.fetch_sub(1, std::memory_order_acq_rel) == 1){
+                destroy(block);
+            }
+        }
+        static SharedStringBlock* allocateBlock(size_t capacity, std::pmr::memory_resource *resource);
+        static void destroy(SharedStringBlock *block) noexcept;
+        // Makes block unique with room for capacity characters, copying the current characters when needed
+        void prepareWrite(size_t capacity);
+
+        SharedStringBlock *block = nullptr;
+
+        friend class AtomicSharedString;
+};
+
+/*
+A SharedString slot that threads can load and replace concurrently, for read-mostly values such as configuration:
+    AtomicSharedString config(SharedString(readFile("app.json")));
+    config.store(SharedString(newContent));      // writer publishes; readers see the old or the new value
+    SharedString current = config.load();        // reader: a stable snapshot, unaffected by later stores
+
+Loading a raw pointer and then incrementing its count is a race (the block may be freed in between), so the slot
+keeps a one-bit spin lock in the low bit of the pointer that is held only for the pointer read and the increment, the
+same scheme libstdc++ uses for std::atomic<std::shared_ptr>. Releasing a replaced value happens outside the lock.
+Readers that poll should use refresh(): when the value has not changed it is one acquire load and a pointer
+compare, touching neither the lock nor the reference count cache line.
+*/
+class AtomicSharedString {
+    public:
+        AtomicSharedString() = default;
+        explicit AtomicSharedString(SharedString value) noexcept : word(reinterpret_cast<uintptr_t>(value.block)) { value.block = nullptr; }
+        ~AtomicSharedString() { SharedString::release(pointer(word.load(std::memory_order_acquire))); }
+
+        AtomicSharedString(const AtomicSharedString&) = delete;
+        AtomicSharedString& operator=(const AtomicSharedString&) = delete;
+
+        SharedString load() const;
+        void store(SharedString value) { exchange(std::move(value)); }
+        SharedString exchange(SharedString value);
+        // Replaces the value with desired only if it still holds expected's block; otherwise expected = current value
+        bool compareExchange(SharedString &expected, SharedString desired);
+        // Updates cached to the current value; false (and no atomic read-modify-write) when it is already current
+        bool refresh(SharedString &cached) const;
+
+    private:
+        static SharedStringBlock* pointer(uintptr_t word) { return reinterpret_cast<SharedStringBlock*>(word & ~uintptr_t(1)); }
+        uintptr_t lock() const;                                          // returns the unlocked word
+        void unlock(uintptr_t value) const { word.store(value, std::memory_order_release); }
+
+        mutable std::atomic<uintptr_t> word{0}; // SharedStringBlock* | lock bit
+};
+
+template <>
+struct std::hash<SharedString> {
+    size_t operator()(const SharedString &str) const { return str.hash(); }
+};
@@ -0,0 +1,92 @@
+#include "StringBuilder.hpp"
+
+StringBuilder::StringBuilder(std::pmr::memory_resource *resource) : resource(resource) {}
+
+StringBuilder::~StringBuilder(){
+    if(buffer){
+        resource->deallocate(buffer, bufferCapacity + 1, alignof(char));
+    }
+}
+
+StringBuilder::StringBuilder(StringBuilder &&other) noexcept
+    : resource(other.resource), buffer(other.buffer), length(other.length), bufferCapacity(other.bufferCapacity) {
+    other.buffer = nullptr;
+    other.length = 0;
+    other.bufferCapacity = 0;
+}
+
+// Moves the characters into a new buffer of exactly newCapacity (+1 for the null-terminator)
+void StringBuilder::reallocate(size_t newCapacity){
+    char *fresh = static_cast<char*>(resource->allocate(newCapacity + 1, alignof(char)));
+    if(buffer){
+        myMemCpy(fresh, buffer, length);
+        resource->deallocate(buffer, bufferCapacity + 1, alignof(char));
+    }
+    buffer = fresh;
+    bufferCapacity = newCapacity;
+}
+
+/*
+Geometric growth: the new capacity is at least double the old one.
+Each character is then copied O(1) times on average over all reallocations (1 + 1/2 + 1/4 + ... < 2).
+*/
+void StringBuilder::grow(size_t minCapacity){
+    size_t newCapacity = bufferCapacity ? bufferCapacity * 2 : 32;
+    reallocate(newCapacity < minCapacity ? minCapacity : newCapacity);
+}
+
+void StringBuilder::reserve(size_t newCapacity){
+    if(newCapacity > bufferCapacity){
+        reallocate(newCapacity);
+    }
+}
+
+StringBuilder& StringBuilder::append(char c){
+    *makeRoom(1) = c;
+    length++;
+    return *this;
+}
+
+StringBuilder& StringBuilder::append(const char *str){
+    return str ? append(str, std::strlen(str)) : *this;
+}
+
+StringBuilder& StringBuilder::append(const char *str, size_t len){
+    // str may point into our own buffer (appending data() to itself): rebase it if makeRoom reallocates
+    uintptr_t begin = reinterpret_cast<uintptr_t>(buffer), source = reinterpret_cast<uintptr_t>(str);
+    bool aliasesSelf = buffer && source >= begin && source <= begin + length;
+    char *out = makeRoom(len);
+    if(aliasesSelf){
+        str = buffer + (source - begin);
+    }
+    myMemCpy(out, str, len); // The source lies before buffer + length, so the ranges never overlap
+    length += len;
+    return *this;
+}
+
+StringBuilder& StringBuilder::append(const String &str){
+    return append(str.c_str(), str.getLength());
+}
+
+StringBuilder& StringBuilder::append(const std::string &str){
+    return append(str.data(), str.size());
+}
+
+StringBuilder& StringBuilder::append(StringView view){
+    return append(view.data(), view.size());
+}
+
+String StringBuilder::take(){
+    if(length <= String::localCapacity){
+        String result(length, String::UninitializedTag{}, resource); // Inline: no allocation
+        myMemCpy(result.data, data(), length);
+        length = 0;
+        return result;
+    }
+    buffer[length] = '\0';
+    String result(buffer, length, bufferCapacity, resource, String::AdoptTag{});
+    buffer = nullptr;
+    length = 0;
+    bufferCapacity = 0;
+    return result;
+}
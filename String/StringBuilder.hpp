@@ -0,0 +1,71 @@
+#pragma once
+/*
+StringBuilder: incremental construction of a String with amortized O(1) appends.
+
+    StringBuilder builder;
+    builder.reserve(64);
+    builder.append("GET ").append(path).append(' ').append(version);
+    String request = builder.take(); // no copy for long results: the String adopts the buffer
+
+Growth is geometric (capacity doubles), so n appends cost O(n) bytes copied in total instead of O(n^2).
+The buffer always has room for a null-terminator, so take() can hand it to String as is.
+*/
+#include "StringClass.hpp"
+#include <memory_resource>
+#include <string>
+
+class StringBuilder {
+    public:
+        explicit StringBuilder(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+        ~StringBuilder();
+
+        StringBuilder(const StringBuilder&) = delete;
+        StringBuilder& operator=(const StringBuilder&) = delete;
+        StringBuilder(StringBuilder &&other) noexcept;
+
+        // Makes room for at least newCapacity characters; never shrinks
+        void reserve(size_t newCapacity);
+
+        StringBuilder& append(char c);
+        StringBuilder& append(const char *str);
+        StringBuilder& append(const char *str, size_t len);
+        StringBuilder& append(const String &str);
+        StringBuilder& append(const std::string &str);
+        StringBuilder& append(StringView view);
+        template <typename Left, typename Right>
+        StringBuilder& append(const StringConcat<Left, Right> &expression){
+            char *out = makeRoom(expression.size());
+            expression.writeTo(out);
+            length += expression.size();
+            return *this;
+        }
+
+        size_t size() const { return length; }
+        size_t capacity() const { return bufferCapacity; }
+        const char* data() const { return buffer ? buffer : ""; } // not null-terminated until take()
+        void clear() { length = 0; }
+
+        /*
+        Moves the built characters into a String and leaves the builder empty.
+        Long results: the String adopts the buffer, nothing is copied.
+        Short results (fit inline in String): the characters are copied inline and the builder keeps its buffer,
+        so a builder reused in a loop stops allocating after the first iteration.
+        */
+        String take();
+
+    private:
+        // Ensures room for extra more characters and returns where they go
+        char* makeRoom(size_t extra){
+            if(length + extra > bufferCapacity){
+                grow(length + extra);
+            }
+            return buffer + length;
+        }
+        void grow(size_t minCapacity);
+        void reallocate(size_t newCapacity);
+
+        std::pmr::memory_resource *resource;
+        char *buffer = nullptr;       // bufferCapacity + 1 bytes (room for the null-terminator)
+        size_t length = 0;
+        size_t bufferCapacity = 0;
+};
@@ -39,6 +39,15 @@ Now, in my class first, we'll define the private members to hold the string data
 Then, I'll implement the member functions accordingly. This is added in StringClass.hpp file.
 */
 #include "StringClass.hpp"
+#include "../myCase.hpp"
+#include "../myMemCpy.hpp"
+#include "../myMemMem.hpp"
+#include "../myMemOps.hpp"
+#include "../myUtf8.hpp"
+#include "../instrumentation.hpp"
+#include "../memoryResources.hpp"
+#include <cstdint>
+#include <stdexcept>
 // Default Constructor
 /*
 Members are default-initialized first
@@ -70,23 +79,74 @@ Then constructor body runs:
    If another class which only has parameterized constructors is a member, it must be initialized this way.
 */
 // Default Constructor
-String::String() : data(new char[1]),length(0) {
-    data[0] = '\0'; // Null-terminate
+/*
+With SSO the default constructor no longer allocates: data points at the inline buffer
+and the empty string is just a null-terminator stored inside the object.
+*/
+String::String() : data(localBuffer),length(0),resource(std::pmr::get_default_resource()) {
+    INSTRUMENT_COUNT(StringDefaultConstructions);
+    localBuffer[0] = '\0'; // Null-terminate
+}
+
+char* String::allocateHeap(size_t len) {
+    INSTRUMENT_COUNT(StringHeapAllocations);
+    INSTRUMENT_ADD(StringHeapBytes, len + 1);
+    return static_cast<char*>(resource->allocate(len + 1, alignof(char))); // +1 for null-terminator
+}
+
+void String::allocateBuffer(size_t len) {
+    if(len <= localCapacity){
+        data = localBuffer; // Fits inline: no heap allocation
+        return;
+    }
+    data = allocateHeap(len); // If allocation throws, data is left untouched
+    capacity = len;
+}
+
+void String::releaseBuffer() noexcept {
+    if(!isLocal()){
+        resource->deallocate(data, capacity + 1, alignof(char)); // Only heap mode owns a heap block
+    }
+}
+
+/*
+Allocate before deleting: the new block is allocated and filled before the old one is released,
+so if the allocation throws, the string still holds its old value (strong guarantee).
+When the current buffer is already large enough, no allocation happens at all.
+*/
+void String::assign(const char *str, size_t len) {
+    invalidateCaches();
+    if(len <= currentCapacity()){
+        myMemMove(data, str, len); // str may point into our own buffer
+        data[len] = '\0';
+        length = len;
+        return;
+    }
+    char *fresh = allocateHeap(len);
+    myMemCpy(fresh, str, len);
+    fresh[len] = '\0';
+    releaseBuffer();
+    data = fresh;
+    capacity = len;
+    length = len;
 }
 
 // Constructor from C-style string
-String::String(const char *str) : data(nullptr), length(0) {    //Here, if new throws exception, object is still in valid state with data as nullptr and length as 0.
+String::String(const char *str) : String(str, std::pmr::get_default_resource()) {}
+
+String::String(const char *str, std::pmr::memory_resource *resource) : data(localBuffer), length(0), resource(resource) {    //Here, if new throws exception, no heap block has been taken yet, so nothing leaks.
+    INSTRUMENT_COUNT(StringCStringConstructions);
+    localBuffer[0] = '\0';
     if(!str){
         // Handle null pointer input and return empty string i.e. null terminated string with length 0
-        data = new char[1];
-        data[0] = '\0';
         return;
     }
     
-    length = std::strlen(str);
-    data = new char[length + 1]; // +1 for null-terminator
+    size_t len = std::strlen(str);
+    allocateBuffer(len); // Inline when len <= localCapacity, heap otherwise
+    length = len;
     //std::strcpy(data,str); // Copy the string data from str to data- This is correct but strcpy rescans str until /0 but we know the length already
-    std::memcpy(data, str, length + 1); // Copy including null-terminator
+    myMemCpy(data, str, length + 1); // Copy including null-terminator
 
 }
 
@@ -121,9 +181,23 @@ When a and b go out of scope, both will try to delete the same memory, causing u
 Since, objects are destroyed in reverse order of creation, first b deletes the memory, then a tries to delete the already freed memory.
 */
 // Copy Constructor
-String::String(const String &stringToCopy)  : data(nullptr), length(stringToCopy.length) {
-    data = new char[length + 1]; // Allocate memory for the copied string
-    std::memcpy(data, stringToCopy.data, length + 1); // Copy including null-terminator
+String::String(const String &stringToCopy)  : String(stringToCopy, std::pmr::get_default_resource()) {}
+
+String::String(const String &stringToCopy, std::pmr::memory_resource *resource)
+    : data(localBuffer), length(stringToCopy.length), resource(resource),
+      cachedHash(stringToCopy.cachedHash.load(std::memory_order_relaxed)),
+      cachedUtf8(stringToCopy.cachedUtf8.load(std::memory_order_relaxed)) {
+    INSTRUMENT_COPY(StringCopyConstructions, length);
+    allocateBuffer(length); // Short strings are copied inline, only long strings hit the heap
+    myMemCpy(data, stringToCopy.data, length + 1); // Copy including null-terminator
+}
+
+String::String(StringView view, std::pmr::memory_resource *resource)
+    : data(localBuffer), length(view.size()), resource(resource) {
+    INSTRUMENT_COUNT(StringViewConstructions);
+    allocateBuffer(length);
+    myMemCpy(data, view.data(), length); // A view is not null-terminated
+    data[length] = '\0';
 }
 
 /* WRONG Copy Constructor implementation:
@@ -150,7 +224,7 @@ void String::printString(const String& str) const {
 }
 
 String::~String() {
-    delete[] data; // Free allocated memory
+    releaseBuffer(); // Free allocated memory (nothing to free for inline strings)
 }
 /* Move Constructor */
 /*
@@ -161,76 +235,538 @@ Move constructor is invoked when an rvalue (temporary object) is used to initial
 String a = String("Temporary"); // Move constructor is called here
 The move constructor transfers ownership of resources from the temporary object to the new object, leaving the temporary in a valid but unspecified state.
 */
+/*
+With SSO there are two cases:
+    1. Source is inline: its bytes live inside the source object, so they must be copied (at most localCapacity + 1 bytes).
+    2. Source is on the heap: steal the pointer and capacity as before.
+In both cases the moved-from object becomes an inline empty string, which needs no allocation.
+Previously the moved-from object got a fresh new char[1], which could throw inside a noexcept function.
+*/
 String::String(String &&stringToMove) noexcept 
-    : data(stringToMove.data), length(stringToMove.length) {
+    : data(localBuffer), length(stringToMove.length), resource(stringToMove.resource),
+      cachedHash(stringToMove.cachedHash.load(std::memory_order_relaxed)),
+      cachedUtf8(stringToMove.cachedUtf8.load(std::memory_order_relaxed)) {
+    INSTRUMENT_COUNT(StringMoveConstructions);
+    if(stringToMove.isLocal()){
+        myMemCpy(localBuffer, stringToMove.localBuffer, length + 1); // Copy including null-terminator
+    }
+    else{
+        data = stringToMove.data; // Take ownership of the heap block
+        capacity = stringToMove.capacity;
+    }
     // Leave stringToMove in a valid state
-    stringToMove.data = new char[1]; // Allocate memory for empty string
-    stringToMove.data[0] = '\0';
+    stringToMove.data = stringToMove.localBuffer;
+    stringToMove.localBuffer[0] = '\0';
     stringToMove.length = 0;
+    stringToMove.invalidateCaches();
+}
+
+/*
+swap cannot simply exchange the data pointers: an inline string's data points INTO its own object.
+    - both heap: exchange pointers, lengths and capacities.
+    - both local: exchange the inline buffers.
+    - mixed: the heap block moves to the local one, and the inline bytes are copied into the other object.
+No case allocates, so swap is noexcept.
+The memory resources are swapped too: each heap block must be released to the resource it came from.
+*/
+void String::swap(String &other) noexcept {
+    if(this == &other){
+        return;
+    }
+    std::swap(resource, other.resource);
+    uint64_t otherHash = other.cachedHash.load(std::memory_order_relaxed);
+    other.cachedHash.store(cachedHash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    cachedHash.store(otherHash, std::memory_order_relaxed);
+    uint64_t otherUtf8 = other.cachedUtf8.load(std::memory_order_relaxed);
+    other.cachedUtf8.store(cachedUtf8.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    cachedUtf8.store(otherUtf8, std::memory_order_relaxed);
+    if(!isLocal() && !other.isLocal()){
+        std::swap(data, other.data);
+        std::swap(length, other.length);
+        std::swap(capacity, other.capacity);
+        return;
+    }
+    if(isLocal() && other.isLocal()){
+        char temp[localCapacity + 1];
+        myMemCpy(temp, localBuffer, length + 1);
+        myMemCpy(localBuffer, other.localBuffer, other.length + 1);
+        myMemCpy(other.localBuffer, temp, length + 1);
+        std::swap(length, other.length);
+        return;
+    }
+    String &localStr = isLocal() ? *this : other;
+    String &heapStr = isLocal() ? other : *this;
+    char *heapData = heapStr.data;
+    size_t heapCapacity = heapStr.capacity;
+    size_t heapLength = heapStr.length;
+
+    myMemCpy(heapStr.localBuffer, localStr.localBuffer, localStr.length + 1); // Overwrites heapStr.capacity, already saved
+    heapStr.data = heapStr.localBuffer;
+    heapStr.length = localStr.length;
+
+    localStr.data = heapData;
+    localStr.capacity = heapCapacity;
+    localStr.length = heapLength;
+}
+
+/*
+Private constructors used by StringConcat and StringBuilder.
+The uninitialized one sizes the buffer once for a result whose length is already known; the caller fills it.
+The adopting one takes over a heap block built by StringBuilder, so StringBuilder::take() copies nothing.
+*/
+String::String(size_t len, UninitializedTag, std::pmr::memory_resource *resource)
+    : data(localBuffer), length(len), resource(resource) {
+    INSTRUMENT_COUNT(StringBuiltConstructions);
+    allocateBuffer(len);
+    data[len] = '\0';
+}
+
+String::String(char *buffer, size_t len, size_t capacity, std::pmr::memory_resource *resource, AdoptTag) noexcept
+    : data(buffer), length(len), resource(resource) {
+    INSTRUMENT_COUNT(StringBuiltConstructions);
+    this->capacity = capacity;
 }
 
 //Copy Assignment Operator
-String& String::operator=(String stringToCopy){
-    if( this != &stringToCopy){
-        //Self-assignment check eg. String a; a = a;
-        delete[] data; // Free existing memory
-        length = stringToCopy.length;
-        data = new char[length + 1]; // Allocate new memory
-        std::memcpy(data, stringToCopy.data, length + 1); // Copy including null-terminator
+/*
+assign() reuses our buffer when it is large enough and otherwise allocates before releasing, so a throwing
+allocation leaves *this unchanged. Our resource is kept, and the source's caches are valid for the copied bytes.
+*/
+String& String::operator=(const String &stringToCopy){
+    if(this == &stringToCopy){
+        return *this;
     }
+    INSTRUMENT_COPY(StringCopyAssignments, stringToCopy.length);
+    assign(stringToCopy.data, stringToCopy.length);
+    cachedHash.store(stringToCopy.cachedHash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    cachedUtf8.store(stringToCopy.cachedUtf8.load(std::memory_order_relaxed), std::memory_order_relaxed);
     return *this;
 }
 
 //Move Assignment Operator
+/*
+    - source on the heap, same resource: release our block and take the source's (no copy, no allocation),
+    - source inline: copy its at most localCapacity + 1 bytes into our current buffer, which is kept (a heap
+      buffer stays available for later appends),
+    - different resources: the block cannot change owners, so the characters are copied (assign) and the source's
+      block is released.
+The source is left as an empty inline string.
+*/
+String& String::operator=(String &&stringToMove){
+    if(this == &stringToMove){
+        return *this;
+    }
+    INSTRUMENT_COUNT(StringMoveAssignments);
+    if(stringToMove.isLocal() || *resource != *stringToMove.resource){
+        assign(stringToMove.data, stringToMove.length);
+        // A heap source keeps its block: free it before localBuffer is written, as that overlays capacity
+        stringToMove.releaseBuffer();
+        stringToMove.data = stringToMove.localBuffer;
+    }
+    else{
+        releaseBuffer();
+        data = stringToMove.data;
+        length = stringToMove.length;
+        capacity = stringToMove.capacity;
+        stringToMove.data = stringToMove.localBuffer;
+    }
+    cachedHash.store(stringToMove.cachedHash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    cachedUtf8.store(stringToMove.cachedUtf8.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    stringToMove.localBuffer[0] = '\0';
+    stringToMove.length = 0;
+    stringToMove.invalidateCaches();
+    return *this;
+}
+
+char& String::operator[](size_t index){
+    invalidateCaches();
+    return data[index];
+}
+
+bool String::operator==(const String &other) const {
+    return length == other.length && myMemCmp(data, other.data, length) == 0;
+}
+
+// Concatenation Assignment Operators: append in place when the buffer has room, grow geometrically otherwise
+String& String::operator+=(const String &stringToAppend){
+    appendBytes(stringToAppend.data, stringToAppend.length);
+    return *this;
+}
+
+String& String::operator+=(const char *strToAppend){
+    if(strToAppend){
+        appendBytes(strToAppend, std::strlen(strToAppend));
+    }
+    return *this;
+}
+
+String& String::operator+=(const char charToAppend){
+    pushBack(charToAppend);
+    return *this;
+}
+
+String& String::operator+=(const std::string &strToAppend){
+    appendBytes(strToAppend.data(), strToAppend.size());
+    return *this;
+}
+
+String& String::operator+=(StringView viewToAppend){
+    appendBytes(viewToAppend.data(), viewToAppend.size());
+    return *this;
+}
+
+/* Capacity */
+
+void String::reallocateBuffer(size_t newCapacity){
+    if(newCapacity <= localCapacity){
+        if(!isLocal()){
+            // localBuffer shares its bytes with capacity: read the heap block's size before overwriting it
+            char *heap = data;
+            size_t heapCapacity = capacity;
+            myMemCpy(localBuffer, heap, length + 1);
+            data = localBuffer;
+            resource->deallocate(heap, heapCapacity + 1, alignof(char));
+        }
+        return;
+    }
+    if(!isLocal()){
+        if(ReallocResource *growable = dynamic_cast<ReallocResource*>(resource)){
+            INSTRUMENT_COUNT(StringHeapAllocations);
+            INSTRUMENT_ADD(StringHeapBytes, newCapacity + 1);
+            data = static_cast<char*>(growable->reallocate(data, capacity + 1, newCapacity + 1, alignof(char)));
+            capacity = newCapacity;
+            return;
+        }
+    }
+    char *fresh = allocateHeap(newCapacity);
+    myMemCpy(fresh, data, length + 1);
+    releaseBuffer();
+    data = fresh;
+    capacity = newCapacity;
+}
+
+void String::appendBytes(const char *str, size_t len){
+    invalidateCaches();
+    size_t newLength = length + len;
+    if(newLength > currentCapacity()){
+        // str may point into this string (s += s): remember its offset, the buffer is about to move
+        uintptr_t begin = reinterpret_cast<uintptr_t>(data), source = reinterpret_cast<uintptr_t>(str);
+        bool aliasesSelf = source >= begin && source <= begin + length;
+        reallocateBuffer(grownCapacity(newLength));
+        if(aliasesSelf){
+            str = data + (source - begin);
+        }
+    }
+    myMemCpy(data + length, str, len); // The source lies before data + length, so the ranges never overlap
+    length = newLength;
+    data[length] = '\0';
+}
+
+void String::reserve(size_t newCapacity){
+    if(newCapacity > currentCapacity()){
+        reallocateBuffer(newCapacity);
+    }
+}
+
+void String::shrinkToFit(){
+    if(!isLocal() && capacity > length){
+        reallocateBuffer(length);
+    }
+}
+
+void String::resize(size_t newLength, char fill){
+    invalidateCaches();
+    if(newLength > length){
+        if(newLength > currentCapacity()){
+            reallocateBuffer(grownCapacity(newLength));
+        }
+        myMemSet(data + length, fill, newLength - length);
+    }
+    length = newLength;
+    data[length] = '\0';
+}
+
+String& String::append(size_t count, char c){
+    resize(length + count, c);
+    return *this;
+}
+
+/*
+Shifts the tail right and copies text into the gap. If text points into this string, shifting would overwrite it,
+so it is copied out first (rare, and never allocates for short texts).
+*/
+String& String::insert(size_t pos, StringView text){
+    if(pos > length){
+        throw std::out_of_range("String::insert: position past the end");
+    }
+    uintptr_t begin = reinterpret_cast<uintptr_t>(data), source = reinterpret_cast<uintptr_t>(text.data());
+    if(!text.empty() && source >= begin && source <= begin + length){
+        String copy(text);
+        return insert(pos, copy.view());
+    }
+    invalidateCaches();
+    size_t newLength = length + text.size();
+    if(newLength > currentCapacity()){
+        reallocateBuffer(grownCapacity(newLength));
+    }
+    myMemMove(data + pos + text.size(), data + pos, length - pos + 1); // Including the null-terminator
+    myMemCpy(data + pos, text.data(), text.size());
+    length = newLength;
+    return *this;
+}
+
+String& String::erase(size_t pos, size_t count){
+    if(pos > length){
+        throw std::out_of_range("String::erase: position past the end");
+    }
+    invalidateCaches();
+    if(count > length - pos){
+        count = length - pos;
+    }
+    myMemMove(data + pos, data + pos + count, length - pos - count + 1); // Including the null-terminator
+    length -= count;
+    return *this;
+}
 
+/* Search */
 
-int main(){
-    //Example usage of the String class
-    String str1; // Default constructor
-    std::cout << "str1: "<<str1.c_str()<<" Length: "<<str1.getLength()<<std::endl;
+size_t String::findBytes(const char *needle, size_t needleLength, size_t pos) const {
+    if(pos > length){
+        return npos;
+    }
+    const char *hit = myMemMem(data + pos, length - pos, needle, needleLength);
+    return hit ? static_cast<size_t>(hit - data) : npos;
+}
 
-    String str2("Hello, World!"); //Passing string literal i.e. RO data/ // Constructor from C-style string
-    std::cout << "str2: "<<str2.c_str()<<" Length: "<<str2.getLength()<<std::endl;
+size_t String::rfindBytes(const char *needle, size_t needleLength) const {
+    const char *hit = myMemRMem(data, length, needle, needleLength);
+    return hit ? static_cast<size_t>(hit - data) : npos;
+}
 
-    String str3(str2);  // Copy Constructor
-    std::cout << "str3 (copy of str2): "<<str3.c_str()<<" Length: "<<str3.getLength()<<std::endl;
+size_t String::find(const char *needle, size_t pos) const {
+    return needle ? findBytes(needle, std::strlen(needle), pos) : npos;
+}
 
-    String str3_copy = str2;  // Copy Constructor via direct initialization
-    std::cout << "str3_copy (copy of str2 via direct initialization): "<<str3_copy.c_str()<<" Length: "<<str3_copy.getLength()<<std::endl;
+size_t String::find(const String &needle, size_t pos) const {
+    return findBytes(needle.data, needle.length, pos);
+}
 
-    String str4(nullptr); // Handle null pointer input
-    std::cout << "str4 (from nullptr): "<<str4.c_str()<<" Length: "<<str4.getLength()<<std::endl;
+size_t String::find(StringView needle, size_t pos) const {
+    return findBytes(needle.data(), needle.size(), pos);
+}
 
-    char array[] = "Sample C-Style String";
-    String str5(array); // Constructor from C-style string
-    std::cout << "str5: "<<str5.c_str()<<" Length: "<<str5.getLength()<<std::endl;
+size_t String::rfind(const char *needle) const {
+    return needle ? rfindBytes(needle, std::strlen(needle)) : npos;
+}
 
-    const char *array2 = array;
-    String str6(array2); // Constructor from C-style string
-    std::cout << "str6: "<<str6.c_str()<<" Length: "<<str6.getLength()<<std::endl;  
+size_t String::rfind(const String &needle) const {
+    return rfindBytes(needle.data, needle.length);
+}
 
-    std::string str7 = "Reference std::string";
-    std::string &refStr = str7;
-    String str8(refStr.c_str()); // Copy Constructor using reference
-    std::cout << "str8 (copy of str2 via reference): "<<str8.c_str()<<" Length: "<<str8.getLength()<<std::endl;
+size_t String::findFirstOf(const char *set, size_t pos) const {
+    if(!set || pos > length){
+        return npos;
+    }
+    const char *hit = myFindFirstOf(data + pos, length - pos, set, std::strlen(set));
+    return hit ? static_cast<size_t>(hit - data) : npos;
+}
 
-    String & str9 = str2; // Reference to existing String object
-    String str10(str9); // Copy Constructor using String reference
-    std::cout << "str10 (copy of str2 via String reference): "<<str10.c_str()<<" Length: "<<str10.getLength()<<std::endl;   
+size_t String::countBytes(const char *needle, size_t needleLength) const {
+    if(needleLength == 0){
+        return 0;
+    }
+    size_t matches = 0;
+    const char *cursor = data;
+    const char *end = data + length;
+    while(const char *hit = myMemMem(cursor, end - cursor, needle, needleLength)){
+        matches++;
+        cursor = hit + needleLength; // Non-overlapping: continue after the match
+    }
+    return matches;
+}
 
-    //Move Constructor
-    String str11(String("Temporary String")); // Move constructor
-    std::cout << "str11 (moved from temporary): "<<str11.c_str()<<" Length: "<<str11.getLength()<<std::endl;    
-    String str12(std::move(str2)); // Move constructor using std::move
-    std::cout << "str12 (moved from str2): "<<str12.c_str()<<" Length: "<<str12.getLength()<<std::endl;    
-    std::cout << "str2 after move: "<<str2.c_str()<<" Length: "<<str2.getLength()<<std::endl;
+size_t String::count(const char *needle) const {
+    return needle ? countBytes(needle, std::strlen(needle)) : 0;
+}
 
-    //Copy Assignment Operator
-    String str13;
-    str13 = str3; // Copy Assignment Operator
-    std::cout << "str13 (after copy assignment from str3): "<<str13.c_str()<<" Length: "<<str13.getLength()<<std::endl;
+size_t String::count(const String &needle) const {
+    return countBytes(needle.data, needle.length);
+}
 
-    //Overloading << and >> operators for printing and input can be added later
+/*
+replaceAll in two passes over the haystack:
+    1. count the matches, which gives the exact result length,
+    2. allocate once and copy the unchanged runs and the replacements into place.
+When from and to have the same length the result has the same length too, so it is rewritten in place with no
+allocation at all (unless from/to point into this string, whose bytes we are about to overwrite).
+*/
+size_t String::replaceAllBytes(const char *from, size_t fromLength, const char *to, size_t toLength){
+    size_t matches = countBytes(from, fromLength);
+    if(matches == 0){
+        return 0;
+    }
+    const char *end = data + length;
+    bool aliasesSelf = (to >= data && to < end) || (from >= data && from < end);
+    if(fromLength == toLength && !aliasesSelf){
+        invalidateCaches();
+        char *cursor = data;
+        while(char *hit = const_cast<char*>(myMemMem(cursor, end - cursor, from, fromLength))){
+            myMemCpy(hit, to, toLength);
+            cursor = hit + fromLength;
+        }
+        return matches;
+    }
 
-    return 0;
+    size_t newLength = length - matches * fromLength + matches * toLength;
+    String result(newLength, UninitializedTag{}, resource);
+    char *out = result.data;
+    const char *cursor = data;
+    while(const char *hit = myMemMem(cursor, end - cursor, from, fromLength)){
+        myMemCpy(out, cursor, hit - cursor);
+        out += hit - cursor;
+        myMemCpy(out, to, toLength);
+        out += toLength;
+        cursor = hit + fromLength;
+    }
+    myMemCpy(out, cursor, end - cursor);
+    swap(result); // Same resource on both sides; the old buffer is released by result's destructor
+    return matches;
+}
+
+size_t String::replaceAll(const char *from, const char *to){
+    if(!from){
+        return 0;
+    }
+    return replaceAllBytes(from, std::strlen(from), to ? to : "", to ? std::strlen(to) : 0);
+}
+
+size_t String::replaceAll(const String &from, const String &to){
+    return replaceAllBytes(from.data, from.length, to.data, to.length);
+}
+
+/* Case conversion */
+
+String& String::toUpper(){
+    invalidateHash();
+    myToUpper(data, data, length);
+    return *this;
+}
+
+String& String::toLower(){
+    invalidateHash();
+    myToLower(data, data, length);
+    return *this;
+}
+
+// Converts straight into the new buffer: one pass, no copy followed by an in-place conversion
+String String::toUpperCopy() const {
+    String result(length, UninitializedTag{}, std::pmr::get_default_resource());
+    myToUpper(result.data, data, length);
+    return result;
+}
+
+String String::toLowerCopy() const {
+    String result(length, UninitializedTag{}, std::pmr::get_default_resource());
+    myToLower(result.data, data, length);
+    return result;
+}
+
+/* UTF-8 */
+
+uint64_t String::computeUtf8Info() const {
+    if(myIsAscii(data, length)){
+        return utf8Known | utf8Valid | utf8Ascii | length;
+    }
+    uint64_t info = utf8Known | myUtf8CountCodePoints(data, length);
+    if(myUtf8Validate(data, length)){
+        info |= utf8Valid;
+    }
+    return info;
+}
+
+// A UTF-8 string never has more UTF-16/32 units than bytes, so the result is sized by length and trimmed
+std::u16string String::toUtf16() const {
+    std::u16string result(length, u'\0');
+    size_t units = myUtf8ToUtf16(data, length, result.data());
+    if(units == myUtfError){
+        throw std::invalid_argument("String::toUtf16: malformed UTF-8");
+    }
+    result.resize(units);
+    return result;
+}
+
+std::u32string String::toUtf32() const {
+    std::u32string result(isAscii() ? length : codePointCount(), U'\0');
+    size_t units = myUtf8ToUtf32(data, length, result.data());
+    if(units == myUtfError){
+        throw std::invalid_argument("String::toUtf32: malformed UTF-8");
+    }
+    return result;
+}
+
+// The exact UTF-8 size is computed first, so the result is allocated once and written in place
+String String::fromUtf16(std::u16string_view text, std::pmr::memory_resource *resource){
+    String result(myUtf8LengthFromUtf16(text.data(), text.size()), UninitializedTag{}, resource);
+    if(myUtf16ToUtf8(text.data(), text.size(), result.data) == myUtfError){
+        throw std::invalid_argument("String::fromUtf16: unpaired surrogate");
+    }
+    return result;
+}
+
+String String::fromUtf32(std::u32string_view text, std::pmr::memory_resource *resource){
+    String result(myUtf8LengthFromUtf32(text.data(), text.size()), UninitializedTag{}, resource);
+    if(myUtf32ToUtf8(text.data(), text.size(), result.data) == myUtfError){
+        throw std::invalid_argument("String::fromUtf32: surrogate or value above U+10FFFF");
+    }
+    // Valid by construction, one code point per input unit
+    result.cachedUtf8.store(utf8Known | utf8Valid | text.size() | (text.size() == result.length ? utf8Ascii : 0), std::memory_order_relaxed);
+    return result;
+}
+
+std::ostream& operator<<(std::ostream &out, const String &str){
+    return out << std::string_view(str.c_str(), str.getLength());
+}
+
+/*
+Reads straight from the stream buffer instead of extracting one character at a time through the istream, and appends
+in chunks so a long word costs a few appends rather than one pushBack per character.
+*/
+std::istream& operator>>(std::istream &in, String &str){
+    std::istream::sentry sentry(in); // skips leading whitespace
+    if(!sentry){
+        return in;
+    }
+    str.clear();
+    std::streamsize width = in.width();
+    size_t limit = width > 0 ? static_cast<size_t>(width) : String::npos;
+    const std::ctype<char> &ctype = std::use_facet<std::ctype<char>>(in.getloc());
+    std::streambuf *buffer = in.rdbuf();
+    std::ios_base::iostate state = std::ios_base::goodbit;
+    char chunk[256];
+    size_t used = 0;
+    size_t extracted = 0;
+    int c = buffer->sgetc();
+    while(true){
+        if(c == std::char_traits<char>::eof()){
+            state |= std::ios_base::eofbit;
+            break;
+        }
+        if(extracted == limit || ctype.is(std::ctype_base::space, static_cast<char>(c))){
+            break;
+        }
+        chunk[used++] = static_cast<char>(c);
+        ++extracted;
+        if(used == sizeof(chunk)){
+            str.append(chunk, used);
+            used = 0;
+        }
+        c = buffer->snextc();
+    }
+    str.append(chunk, used);
+    in.width(0);
+    if(extracted == 0){
+        state |= std::ios_base::failbit;
+    }
+    in.setstate(state);
+    return in;
 }
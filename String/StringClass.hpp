@@ -1,11 +1,33 @@
+#pragma once
 #include<iostream>
+#include <atomic>
 #include <cstring>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include "../myHash.hpp"
+#include "../myMemCpy.hpp"
+#include "StringView.hpp"
+
+template <typename Left, typename Right> class StringConcat;
+class StringBuilder;
 
 class String {
+    public:
+        /*
+        Small String Optimization (SSO):
+        Most strings in practice (keys, tags, names) are short. Allocating a heap block for each of them
+        costs a malloc/free pair and a pointer chase on every access. Instead, the object carries a small
+        inline buffer and short strings live inside the object itself.
+        localCapacity is the number of characters (excluding the null-terminator) that fit inline.
+        */
+        static constexpr size_t localCapacity = 23;
+
     private:
         /*
         Char pointer to hold the string data.
-        Heap-allocated buffer to store the actual string characters.
+        It ALWAYS points to the active buffer: either localBuffer (short string) or a heap-allocated block (long string).
+        Because data is always valid, c_str() is a plain load and needs no branch on the storage mode.
         */
         char *data;
          /*
@@ -25,6 +47,143 @@ class String {
         // length of the string excluding null-terminator. We will keep data null-terminated by default.
         size_t length;  
 
+        /*
+        Storage for the two modes shares the same bytes:
+            - Local mode (data == localBuffer): characters are stored inline, no heap allocation at all.
+            - Heap mode  (data != localBuffer): localBuffer is unused, so the same bytes hold the heap capacity.
+        | Mode  | data points to | capacity           |
+        | ----- | -------------- | ------------------ |
+        | Local | localBuffer    | localCapacity      |
+        | Heap  | new char[]     | stored in union    |
+        */
+        union {
+            char localBuffer[localCapacity + 1]; // +1 for null-terminator
+            size_t capacity; // characters the heap block can hold (excluding null-terminator)
+        };
+
+        /*
+        Where heap buffers come from.
+        Instead of hard-coding new[]/delete[], every heap allocation goes through a std::pmr::memory_resource.
+        The default is std::pmr::get_default_resource() (plain operator new/delete), but a caller can pass an arena
+        (see memoryResources.hpp) so that all strings of a request are freed together by resetting the arena.
+        Inline (SSO) strings never touch the resource.
+        Semantics follow std::pmr containers:
+            - copy construction uses the default resource (a copy may outlive the source's arena),
+            - move construction keeps the source's resource (the buffer is stolen, not copied),
+            - assignment never changes the target's resource.
+        */
+        std::pmr::memory_resource *resource;
+
+        /*
+        Lazily computed myHash of the characters, 0 = not computed yet.
+        Hash-keyed containers hash the same key on every lookup; caching it makes repeated lookups with the same
+        String free. Every mutation resets it (invalidateHash), copies and moves carry it along.
+        It is atomic only so that two threads calling hash() on the same const String do not race; relaxed loads
+        and stores compile to plain moves.
+        */
+        mutable std::atomic<uint64_t> cachedHash{0};
+
+        /*
+        Lazily computed UTF-8 facts about the characters, 0 = not computed yet. Packed into one word so that a single
+        relaxed load answers isAscii/isValidUtf8/codePointCount:
+            bit 63 = computed, bit 62 = valid UTF-8, bit 61 = pure ASCII, bits 0..60 = code point count.
+        Pure-ASCII text (the common case) costs one vectorized OR-scan; only other text is validated and counted.
+        */
+        static constexpr uint64_t utf8Known = uint64_t(1) << 63;
+        static constexpr uint64_t utf8Valid = uint64_t(1) << 62;
+        static constexpr uint64_t utf8Ascii = uint64_t(1) << 61;
+        mutable std::atomic<uint64_t> cachedUtf8{0};
+
+        void invalidateHash() { cachedHash.store(0, std::memory_order_relaxed); }
+        // Every mutation that can change the bytes resets both caches; case conversion only resets the hash
+        void invalidateCaches() {
+            invalidateHash();
+            cachedUtf8.store(0, std::memory_order_relaxed);
+        }
+        uint64_t computeUtf8Info() const;
+        uint64_t utf8Info() const {
+            uint64_t info = cachedUtf8.load(std::memory_order_relaxed);
+            if(info == 0){
+                info = computeUtf8Info();
+                cachedUtf8.store(info, std::memory_order_relaxed);
+            }
+            return info;
+        }
+
+        bool isLocal() const { return data == localBuffer; }
+
+        // Characters the active buffer can hold (excluding null-terminator)
+        size_t currentCapacity() const { return isLocal() ? localCapacity : capacity; }
+
+        // Allocates a heap block for len characters plus the null-terminator from resource.
+        char* allocateHeap(size_t len);
+        // Points data at a buffer able to hold len characters plus the null-terminator.
+        // Uses localBuffer when it fits, otherwise allocates on the heap. Does NOT free the previous buffer.
+        void allocateBuffer(size_t len);
+        // Frees the heap block (if any). Local mode has nothing to free.
+        void releaseBuffer() noexcept;
+        /*
+        Moves the characters (and null-terminator) into a buffer able to hold newCapacity characters
+        (newCapacity >= length). Heap blocks of a ReallocResource are resized in place with realloc/mremap;
+        otherwise a new block is allocated, filled and only then is the old one released.
+        A newCapacity that fits inline moves the characters back into localBuffer.
+        */
+        void reallocateBuffer(size_t newCapacity);
+        /*
+        Geometric growth: the capacity at least doubles whenever the buffer is too small, so n appends copy every
+        character O(1) times on average (1 + 1/2 + 1/4 + ... < 2) instead of the whole string on every append.
+        */
+        size_t grownCapacity(size_t required) const {
+            size_t doubled = currentCapacity() * 2;
+            return required > doubled ? required : doubled;
+        }
+        void appendBytes(const char *str, size_t len);
+        // Replaces the contents with len characters from str, reusing the current buffer when it is large enough.
+        void assign(const char *str, size_t len);
+
+        /*
+        Appends extra characters produced by write(char *destination).
+        If they fit in the current buffer they are written in place. Otherwise a new (geometrically grown) buffer is
+        allocated, the old characters are copied, the new ones written, and only THEN is the old buffer released, so
+        a source that points into this string (s += s + "x") stays valid while it is being copied. Plain byte appends
+        go through appendBytes instead, which can also grow in place with realloc/mremap.
+        */
+        template <typename Writer>
+        void appendWith(size_t extra, Writer write){
+            invalidateCaches();
+            size_t newLength = length + extra;
+            if(newLength <= currentCapacity()){
+                write(data + length);
+            }
+            else{
+                size_t newCapacity = grownCapacity(newLength);
+                char *fresh = allocateHeap(newCapacity);
+                myMemCpy(fresh, data, length);
+                write(fresh + length);
+                releaseBuffer();
+                data = fresh;
+                capacity = newCapacity;
+            }
+            length = newLength;
+            data[length] = '\0';
+        }
+
+        // Tags for the private constructors used by StringConcat and StringBuilder
+        struct UninitializedTag {};
+        struct AdoptTag {};
+        // length len, characters left uninitialized (the caller writes them), null-terminated
+        String(size_t len, UninitializedTag, std::pmr::memory_resource *resource);
+        // takes ownership of a heap block of capacity + 1 bytes that was allocated from resource
+        String(char *buffer, size_t len, size_t capacity, std::pmr::memory_resource *resource, AdoptTag) noexcept;
+
+        size_t findBytes(const char *needle, size_t needleLength, size_t pos) const;
+        size_t rfindBytes(const char *needle, size_t needleLength) const;
+        size_t countBytes(const char *needle, size_t needleLength) const;
+        size_t replaceAllBytes(const char *from, size_t fromLength, const char *to, size_t toLength);
+
+        template <typename Left, typename Right> friend class StringConcat;
+        friend class StringBuilder;
+
         public:
         /* 
             Following the Rule of Five:
@@ -56,7 +215,12 @@ class String {
         String();   //Default Constructor
         String(const char *str); // from C-style string
         String(const String &stringToCopy); // Copy Constructor
+        // Allocator-aware constructors: heap buffers (if any) come from resource
+        String(const char *str, std::pmr::memory_resource *resource);
+        String(const String &stringToCopy, std::pmr::memory_resource *resource);
         String(String &&stringToMove) noexcept; // Move Constructor
+        // Materializes a view (e.g. a token of a memory-mapped file). Explicit: this allocates for long views.
+        explicit String(StringView view, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
 
         /* Exception-safety */
         /*
@@ -69,54 +233,243 @@ class String {
         */
        
         //Assignment Operators
-        //Traditional Copy Assignment Operator
-        //String& operator=(const String &stringToCopy); // Copy Assignment Operator
-        //Here, const String &stringToCopy as argument means stringToCopy is an alias to the original object but we are not allowed to modify it through this reference because of const.
-        //This avoids unnecessary copying of the object when passed as argument.
-        //NOTE: This also expresses clear intent to the reader that this function will not modify the source object.
-        
-       // Copy-and-swap form assignment operator
-        String& operator=(String other);
-        //How is this different from traditional copy assignment operator?
         /*
-            1. Exception Safety: The copy-and-swap idiom provides strong exception safety guarantees.
-            2. Code Simplicity: The copy-and-swap idiom can lead to simpler and more maintainable code.
-            3. Self-Assignment Safety: The copy-and-swap idiom inherently handles self-assignment correctly.
-        
-            MyString&          // returns a reference to *this
-            operator=          // assignment operator
-            ( MyString other ) // parameter passed BY VALUE
-
-            To assign one String to another, first make a copy of the source String(RHS string) then swap its data with the current String(LHS string).
-            If any exception occurs during the copy, the current String remains unchanged.
-            After the swap, the temporary copy goes out of scope and its destructor is called, releasing the old resources of the current String.
+        Copy assignment takes const String&. The earlier copy-and-swap form, operator=(String other), took its
+        parameter BY VALUE: it always built a full copy (and a heap allocation for long strings) even when *this
+        already had a large enough buffer, and a = String("x") was ambiguous between it and operator=(String&&),
+        so rvalues could not be assigned at all.
+        Now the characters are copied into the existing buffer when it is large enough (no allocation), otherwise a
+        new buffer is allocated and filled BEFORE the old one is released (allocate before deleting), which keeps the
+        strong guarantee that copy-and-swap gave. Self-assignment is a no-op.
         */
+        String& operator=(const String &stringToCopy); // Copy Assignment Operator
 
-        //Move Assignment Operator
-        String& operator=(String &&stringToMove) noexcept;
-        // noexcept specifier indicates that this function is guaranteed not to throw exceptions.
+        /*
+        Move Assignment Operator: steals the source's heap block (our old block is released) or copies its inline
+        bytes into our current buffer. Assignment never changes the target's resource, so when the resources differ
+        the characters have to be copied into our resource; that may allocate, which is why this is not noexcept
+        (std::pmr::string's move assignment is not noexcept either). With equal resources it never throws.
+        */
+        String& operator=(String &&stringToMove);
 
         String& operator+=(const String &stringToAppend); // Concatenation Assignment Operator
         String& operator+=(const char *strToAppend); // Concatenation Assignment Operator for C-style string
-        String& operator+(const String &other) const; // Concatenation Operator
-        String& operator+(const char *other) const; // Concatenation Operator for C-style string
-        String& operator+(const char other) const; // Concatenation Operator for single character
-        String& operator+(const std::string &other) const; // Concatenation Operator for std::string
-        String& operator==(const String &other) const; // Equality Operator
+        String& operator+=(const char charToAppend); // Concatenation Assignment Operator for single character
+        String& operator+=(const std::string &strToAppend); // Concatenation Assignment Operator for std::string
+        String& operator+=(StringView viewToAppend); // Concatenation Assignment Operator for StringView
+        template <typename Left, typename Right>
+        String& operator+=(const StringConcat<Left, Right> &expression); // Appends a whole a + b + ... chain in one step
+        /*
+        Concatenation Operator (+):
+        a + b cannot return String& from a const member: there is no existing object to refer to, and returning a
+        reference to a local is a dangling reference. It also should not return a String per +, because
+        a + "/" + b + ":" + c would then build and free 3 intermediate Strings.
+        Instead + is a non-member that returns a lightweight StringConcat expression (see StringConcat.hpp) and the
+        characters are only copied, once, when the expression is converted to a String.
+        */
+        // Equality Operators: the lengths are compared first (O(1)), the characters only when the lengths match
+        bool operator==(const String &other) const;
+        bool operator!=(const String &other) const { return !(*this == other); }
+        // Compares without building a temporary String; comparisons with a StringView use operator==(StringView, StringView)
+        bool operator==(const char *other) const { return StringView(data, length) == StringView(other); }
+        bool operator!=(const char *other) const { return !(*this == other); }
 
         //Destructor
         ~String();
+
+        // Exchanges the contents (and memory resources) of two Strings without allocating (used by copy-and-swap)
+        void swap(String &other) noexcept;
+
+        std::pmr::memory_resource* getResource() const { return resource; }
         
     
         //Member Functions
         size_t getLength() const; // Retrieve length of the string in O(1) time
         //Here const at the end means this function does not modify any member variables of the class.
         const char*c_str() const; // Retrieve C-style null-terminated string
+        // Non-owning view of the characters, valid until this String is modified or destroyed
+        StringView view() const { return StringView(data, length); }
+        operator StringView() const { return view(); }
 
+        /*
+        Character access. The non-const overload resets the cached hash and UTF-8 info, because the caller may write
+        through the returned reference; a reference kept across a later hash() call must not be written through.
+        */
         char &operator[](size_t index); // Character access (non-const)
+        char operator[](size_t index) const { return data[index]; }
+
+        /*
+        Capacity and in-place mutation. The capacity counts characters, excluding the null-terminator; an inline
+        string has capacity localCapacity. Appends grow the buffer geometrically (see grownCapacity), so a loop of
+        n pushBack/append calls is O(n) in total; reserve() sizes it up front. Like std::string, positions past the
+        end throw std::out_of_range.
+        */
+        size_t getCapacity() const { return currentCapacity(); }
+        void reserve(size_t newCapacity); // never shrinks
+        void shrinkToFit();               // capacity = length (moves back inline when it fits)
+        void resize(size_t newLength, char fill = '\0');
+        void clear() { invalidateCaches(); length = 0; data[0] = '\0'; } // keeps the buffer
+        void pushBack(char c) {
+            if(length == currentCapacity()){
+                reallocateBuffer(grownCapacity(length + 1));
+            }
+            invalidateCaches();
+            data[length++] = c;
+            data[length] = '\0';
+        }
+        // The common case (it fits) is inline: a short memcpy instead of a call into myMemCpy's dispatcher
+        String& append(const char *str, size_t len) {
+            if(len <= currentCapacity() - length){
+                invalidateCaches();
+                std::memcpy(data + length, str, len); // str lies before data + length if it points into *this
+                length += len;
+                data[length] = '\0';
+                return *this;
+            }
+            appendBytes(str, len);
+            return *this;
+        }
+        String& append(StringView view) { return append(view.data(), view.size()); }
+        String& append(size_t count, char c);
+        String& insert(size_t pos, StringView text);
+        String& erase(size_t pos, size_t count = npos);
+        /*
+        Fills the string from a C-style writer without zero-filling first (modelled on C++23
+        std::string::resize_and_overwrite): makes room for count characters, calls op(char *buffer, size_t count),
+        which writes up to count characters starting at buffer and returns how many it kept (<= count), and sets the
+        length to that. The characters already in the string are preserved in buffer, so op can append to them.
+        Used to read(2) straight into the string (see StringIO.hpp).
+        */
+        template <typename Operation>
+        void resizeAndOverwrite(size_t count, Operation op){
+            if(count > currentCapacity()){
+                reallocateBuffer(count);
+            }
+            invalidateCaches();
+            length = static_cast<size_t>(op(data, count));
+            data[length] = '\0';
+        }
 
         void printString(const String& str) const;
 
-        //SSO Optimizagion can be implemented later
-        //UTF-8 support can be implemented later
-};
\ No newline at end of file
+        /*
+        Search (see myMemMem.hpp for the vectorized kernels).
+        Positions are byte offsets; npos means "not found". An empty needle is found at pos (find) or at the end
+        (rfind), but count() and replaceAll() ignore it: there is no meaningful number of empty matches to replace.
+        count() and replaceAll() work on non-overlapping matches from left to right, like Python's str.count/replace.
+        */
+        static constexpr size_t npos = static_cast<size_t>(-1);
+        size_t find(const char *needle, size_t pos = 0) const;
+        size_t find(const String &needle, size_t pos = 0) const;
+        size_t find(StringView needle, size_t pos = 0) const;
+        size_t rfind(const char *needle) const;
+        size_t rfind(const String &needle) const;
+        size_t findFirstOf(const char *set, size_t pos = 0) const; // first character that is any of the characters in set
+        bool contains(const char *needle) const { return find(needle) != npos; }
+        bool contains(const String &needle) const { return find(needle) != npos; }
+        size_t count(const char *needle) const;
+        size_t count(const String &needle) const;
+        // Replaces every occurrence of from with to and returns the number of replacements.
+        // The result is sized by counting first, so it allocates at most once (never when from and to have equal length).
+        size_t replaceAll(const char *from, const char *to);
+        size_t replaceAll(const String &from, const String &to);
+
+        /*
+        myHash of the characters, computed on first use and cached until the string is modified.
+        Equal to StringView::hash() of the same characters, so a String key and a view/C-string probe hash alike.
+        (A string whose hash happens to be 0 is simply rehashed on every call.)
+        */
+        uint64_t hash() const {
+            uint64_t value = cachedHash.load(std::memory_order_relaxed);
+            if(value == 0){
+                value = myHash(data, length);
+                cachedHash.store(value, std::memory_order_relaxed);
+            }
+            return value;
+        }
+
+        /*
+        ASCII case conversion and case-insensitive comparison (vectorized, see myCase.hpp).
+        Only 'A'..'Z' / 'a'..'z' are mapped; other bytes (including UTF-8) are left as they are.
+        toUpper/toLower convert in place and return *this; the Copy variants leave *this unchanged and allocate the
+        result (from the default resource, like a copy) only when it does not fit inline.
+        */
+        String& toUpper();
+        String& toLower();
+        String toUpperCopy() const;
+        String toLowerCopy() const;
+        bool equalsIgnoreCase(StringView other) const { return view().equalsIgnoreCase(other); }
+        int compareIgnoreCase(StringView other) const { return view().compareIgnoreCase(other); }
+        // Not cached: cachedHash is the case-sensitive hash
+        uint64_t hashIgnoreCase() const { return view().hashIgnoreCase(); }
+
+        // true when the characters are stored inline (no heap allocation)
+        bool isSmall() const { return isLocal(); }
+
+        /*
+        UTF-8 (see myUtf8.hpp). The String stores bytes and getLength() stays a byte count; these answer questions
+        about the bytes as UTF-8, computed on first use and cached until the string is modified.
+        codePointCount() of malformed text counts the bytes that are not continuation bytes.
+        */
+        bool isAscii() const { return (utf8Info() & utf8Ascii) != 0; }
+        bool isValidUtf8() const { return (utf8Info() & utf8Valid) != 0; }
+        size_t codePointCount() const { return static_cast<size_t>(utf8Info() & (utf8Ascii - 1)); }
+
+        // Transcoding; throws std::invalid_argument for malformed input
+        std::u16string toUtf16() const;
+        std::u32string toUtf32() const;
+        static String fromUtf16(std::u16string_view text, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+        static String fromUtf32(std::u32string_view text, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+};
+
+/*
+Stream I/O. operator<< writes the characters with one write of the whole buffer (embedded '\0's included).
+operator>> reads one whitespace-delimited word like it does for std::string: leading whitespace is skipped, width()
+limits the length, the string's buffer is reused, and failbit is set when no character was extracted.
+For bulk line-oriented I/O on files and pipes see LineReader and BatchWriter in StringIO.hpp.
+*/
+std::ostream& operator<<(std::ostream &out, const String &str);
+std::istream& operator>>(std::istream &in, String &str);
+
+/*
+Hashing for unordered containers.
+std::hash<String> uses the cached hash. StringHash and StringEqual are transparent, so a container declared as
+    std::unordered_map<String, V, StringHash, StringEqual>
+can be probed with a const char*, StringView or std::string without building a temporary String:
+    counts.find("GET");   // hashes and compares the literal in place
+*/
+template <>
+struct std::hash<String> {
+    size_t operator()(const String &str) const { return str.hash(); }
+};
+
+struct StringHash {
+    using is_transparent = void;
+    size_t operator()(const String &str) const { return str.hash(); }
+    size_t operator()(StringView view) const { return view.hash(); }
+    size_t operator()(const char *str) const { return StringView(str).hash(); }
+    size_t operator()(const std::string &str) const { return StringView(str).hash(); }
+};
+
+struct StringEqual {
+    using is_transparent = void;
+    bool operator()(StringView lhs, StringView rhs) const { return lhs == rhs; }
+};
+
+/*
+Case-insensitive counterparts, e.g. for HTTP header names:
+    std::unordered_map<String, V, StringHashIgnoreCase, StringEqualIgnoreCase> headers;
+    headers.find("content-length");   // finds a "Content-Length" key without lowering either side
+*/
+struct StringHashIgnoreCase {
+    using is_transparent = void;
+    size_t operator()(StringView view) const { return view.hashIgnoreCase(); }
+    size_t operator()(const char *str) const { return StringView(str).hashIgnoreCase(); }
+};
+
+struct StringEqualIgnoreCase {
+    using is_transparent = void;
+    bool operator()(StringView lhs, StringView rhs) const { return lhs.equalsIgnoreCase(rhs); }
+};
+
+#include "StringConcat.hpp"
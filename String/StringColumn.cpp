@@ -0,0 +1,200 @@
+#include "StringColumn.hpp"
+#include "../cpuFeatures.hpp"
+#include "../myHash.hpp"
+#include "../myMemOps.hpp"
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+StringColumn::StringColumn(std::pmr::memory_resource *resource) : bytes(resource), offsets(resource) {
+    offsets.push_back(0);
+}
+
+StringColumn::StringColumn(size_t rows, size_t byteCount, std::pmr::memory_resource *resource)
+    : bytes(resource), offsets(rows + 1, resource) {
+    bytes.reserve(byteCount); // allocated once, but not zero-filled: fromStrings writes every byte
+}
+
+void StringColumn::reserve(size_t rows, size_t byteCount){
+    offsets.reserve(rows + 1);
+    bytes.reserve(byteCount);
+}
+
+void StringColumn::append(StringView value){
+    size_t end = bytes.size() + value.size();
+    if(end > std::numeric_limits<uint32_t>::max()){
+        throw std::length_error("StringColumn: more than 4 GiB of characters");
+    }
+    bytes.insert(bytes.end(), value.begin(), value.end());
+    offsets.push_back(static_cast<uint32_t>(end));
+}
+
+void StringColumn::clear(){
+    bytes.clear();
+    offsets.resize(1);
+}
+
+/*
+Two passes: the first sums the lengths, so both arrays are allocated once at their final size; the second copies
+the characters straight into place.
+*/
+StringColumn StringColumn::fromStrings(const String *strings, size_t count, std::pmr::memory_resource *resource){
+    size_t total = 0;
+    for(size_t i = 0; i < count; i++){
+        total += strings[i].getLength();
+    }
+    if(total > std::numeric_limits<uint32_t>::max()){
+        throw std::length_error("StringColumn: more than 4 GiB of characters");
+    }
+    StringColumn column(count, total, resource);
+    for(size_t i = 0; i < count; i++){
+        const char *chars = strings[i].c_str();
+        column.bytes.insert(column.bytes.end(), chars, chars + strings[i].getLength()); // within the reserved capacity
+        column.offsets[i + 1] = static_cast<uint32_t>(column.bytes.size());
+    }
+    return column;
+}
+
+StringColumn StringColumn::fromStrings(const std::vector<String> &strings, std::pmr::memory_resource *resource){
+    return fromStrings(strings.data(), strings.size(), resource);
+}
+
+std::vector<String> StringColumn::toStrings(std::pmr::memory_resource *resource) const {
+    std::vector<String> strings;
+    strings.reserve(size());
+    for(size_t row = 0; row < size(); row++){
+        strings.emplace_back((*this)[row], resource);
+    }
+    return strings;
+}
+
+/*
+Length kernels.
+Row lengths are offsets[i + 1] - offsets[i]: two overlapping loads of the offsets array and one subtraction give
+the lengths of 8 rows (AVX2) at once. Filters compare those lengths with the wanted one and only the rows whose
+lane matched are looked at further, so a length mismatch, the common case for equality, never reads a character.
+*/
+typedef void (*LengthsFn)(const uint32_t *offsets, size_t rows, uint32_t *out);
+typedef void (*LengthFilterFn)(const uint32_t *offsets, size_t rows, uint32_t length, bool exact, std::vector<uint32_t> &matches);
+
+static void lengthsScalar(const uint32_t *offsets, size_t rows, uint32_t *out){
+    for(size_t i = 0; i < rows; i++){
+        out[i] = offsets[i + 1] - offsets[i];
+    }
+}
+
+static void lengthFilterScalar(const uint32_t *offsets, size_t rows, uint32_t length, bool exact, std::vector<uint32_t> &matches){
+    for(size_t i = 0; i < rows; i++){
+        uint32_t rowLength = offsets[i + 1] - offsets[i];
+        if(exact ? rowLength == length : rowLength >= length){
+            matches.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+#if SIMD_X86
+TARGET_AVX2 static void lengthsAvx2(const uint32_t *offsets, size_t rows, uint32_t *out){
+    size_t i = 0;
+    for(; i + 8 <= rows; i += 8){
+        __m256i begin = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets + i));
+        __m256i end = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets + i + 1));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_sub_epi32(end, begin));
+    }
+    lengthsScalar(offsets + i, rows - i, out + i);
+}
+
+TARGET_AVX2 static void lengthFilterAvx2(const uint32_t *offsets, size_t rows, uint32_t length, bool exact, std::vector<uint32_t> &matches){
+    __m256i wanted = _mm256_set1_epi32(static_cast<int>(length));
+    size_t i = 0;
+    for(; i + 8 <= rows; i += 8){
+        __m256i begin = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets + i));
+        __m256i end = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets + i + 1));
+        __m256i lengths = _mm256_sub_epi32(end, begin);
+        // Unsigned >= : max(lengths, wanted) == lengths
+        __m256i hit = exact ? _mm256_cmpeq_epi32(lengths, wanted) : _mm256_cmpeq_epi32(_mm256_max_epu32(lengths, wanted), lengths);
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(hit)));
+        while(mask){
+            matches.push_back(static_cast<uint32_t>(i + __builtin_ctz(mask)));
+            mask &= mask - 1;
+        }
+    }
+    size_t before = matches.size();
+    lengthFilterScalar(offsets + i, rows - i, length, exact, matches);
+    for(size_t k = before; k < matches.size(); k++){
+        matches[k] += static_cast<uint32_t>(i); // The tail reported rows relative to offsets + i
+    }
+}
+#endif
+
+struct ColumnKernels {
+    LengthsFn lengths;
+    LengthFilterFn lengthFilter;
+};
+
+static const ColumnKernels scalarColumnKernels = {lengthsScalar, lengthFilterScalar};
+#if SIMD_X86
+static const ColumnKernels avx2ColumnKernels = {lengthsAvx2, lengthFilterAvx2};
+#endif
+
+static std::atomic<const ColumnKernels*> activeColumnKernelsPtr{nullptr};
+
+static const ColumnKernels* activeColumnKernels(){
+    const ColumnKernels* kernels = activeColumnKernelsPtr.load(std::memory_order_relaxed);
+    if(!kernels){
+        kernels = &scalarColumnKernels;
+#if SIMD_X86
+        if(cpuFeatures().avx2){
+            kernels = &avx2ColumnKernels;
+        }
+#endif
+        activeColumnKernelsPtr.store(kernels, std::memory_order_relaxed);
+    }
+    return kernels;
+}
+
+void StringColumn::lengths(uint32_t *out) const {
+    activeColumnKernels()->lengths(offsets.data(), size(), out);
+}
+
+void StringColumn::rowsWithLength(uint32_t length, bool exact, std::vector<uint32_t> &rows) const {
+    activeColumnKernels()->lengthFilter(offsets.data(), size(), length, exact, rows);
+}
+
+// The length filter runs first; the characters are compared only for the rows it kept, in place
+std::vector<uint32_t> StringColumn::findEqual(StringView value) const {
+    std::vector<uint32_t> rows;
+    if(value.size() > std::numeric_limits<uint32_t>::max()){
+        return rows;
+    }
+    rowsWithLength(static_cast<uint32_t>(value.size()), true, rows);
+    size_t kept = 0;
+    for(uint32_t row : rows){
+        if(value.empty() || myMemCmp(bytes.data() + offsets[row], value.data(), value.size()) == 0){
+            rows[kept++] = row;
+        }
+    }
+    rows.resize(kept);
+    return rows;
+}
+
+std::vector<uint32_t> StringColumn::findPrefix(StringView prefix) const {
+    std::vector<uint32_t> rows;
+    if(prefix.size() > std::numeric_limits<uint32_t>::max()){
+        return rows;
+    }
+    rowsWithLength(static_cast<uint32_t>(prefix.size()), false, rows);
+    size_t kept = 0;
+    for(uint32_t row : rows){
+        if(prefix.empty() || myMemCmp(bytes.data() + offsets[row], prefix.data(), prefix.size()) == 0){
+            rows[kept++] = row;
+        }
+    }
+    rows.resize(kept);
+    return rows;
+}
+
+// Row hashes are myHash, so they equal String::hash() / StringView::hash() of the same characters
+void StringColumn::hashes(uint64_t *out) const {
+    myHashRows(bytes.data(), offsets.data(), size(), out);
+}
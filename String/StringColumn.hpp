@@ -0,0 +1,69 @@
+#pragma once
+/*
+StringColumn: many strings stored Arrow-style, as one byte blob plus an offsets array.
+
+    bytes   : "GETPOSTGETDELETE"
+    offsets : [0, 3, 7, 10, 16]      row i is bytes[offsets[i], offsets[i + 1])
+
+Compared to std::vector<String>:
+    - one allocation for all the characters (amortized growth) instead of one per long row, and 4 bytes of
+      offset per row instead of a whole String object,
+    - scans walk two dense arrays front to back, which the prefetcher streams, instead of chasing a pointer per row,
+    - row lengths are differences of adjacent offsets, so filters on length run over the offsets alone with vector
+      instructions and only touch the characters of rows that can still match.
+Rows are read back as StringViews into the blob (valid until the next append). Strings are not null-terminated.
+Offsets are 32-bit, so the blob is limited to 4 GiB; appending past that throws std::length_error.
+
+Batch operations return selection vectors (the indices of the matching rows, ascending), which can be fed to the
+next filter or used to gather values.
+*/
+#include "StringClass.hpp"
+#include "StringView.hpp"
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+class StringColumn {
+    public:
+        explicit StringColumn(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+        // Bulk conversion from String arrays: both arrays are allocated exactly once, at their final size
+        static StringColumn fromStrings(const String *strings, size_t count,
+                                        std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+        static StringColumn fromStrings(const std::vector<String> &strings,
+                                        std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+        // Materializes every row (short rows stay inline in their String)
+        std::vector<String> toStrings(std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const;
+
+        void reserve(size_t rows, size_t bytes);
+        void append(StringView value);
+        void clear();
+
+        size_t size() const { return offsets.size() - 1; }
+        bool empty() const { return size() == 0; }
+        size_t byteSize() const { return bytes.size(); } // total characters of all rows
+        StringView operator[](size_t row) const {
+            return StringView(bytes.data() + offsets[row], offsets[row + 1] - offsets[row]);
+        }
+        size_t length(size_t row) const { return offsets[row + 1] - offsets[row]; }
+
+        // out[i] = length of row i, for every row (out must hold size() entries)
+        void lengths(uint32_t *out) const;
+        // Rows equal to value
+        std::vector<uint32_t> findEqual(StringView value) const;
+        // Rows that start with prefix
+        std::vector<uint32_t> findPrefix(StringView prefix) const;
+        // out[i] = hash of row i (out must hold size() entries), computed in batches by myHashRows
+        void hashes(uint64_t *out) const;
+
+        std::pmr::memory_resource* getResource() const { return bytes.get_allocator().resource(); }
+
+    private:
+        // offsets at its final size (all zero), bytes empty with its final capacity; both are filled by fromStrings
+        StringColumn(size_t rows, size_t byteCount, std::pmr::memory_resource *resource);
+        // Rows whose length is exactly length (equal) or at least length (!exact), appended to rows
+        void rowsWithLength(uint32_t length, bool exact, std::vector<uint32_t> &rows) const;
+
+        std::pmr::vector<char> bytes;
+        std::pmr::vector<uint32_t> offsets; // size() + 1 entries, offsets[0] == 0
+};
@@ -0,0 +1,103 @@
+#pragma once
+/*
+Lazy concatenation with expression templates.
+
+    String path = a + "/" + b + ":" + c;
+
+Evaluated eagerly, every + would allocate a new String and copy everything built so far: 4 allocations and O(n^2)
+bytes copied. Here every + only builds a small StringConcat node that remembers its operands (pointer + length) and the
+total length. Nothing is allocated until the expression is converted to a String; at that point:
+    1. the total length is already known (summed once while the nodes were built),
+    2. one buffer of exactly that size is allocated (or none, if it fits inline),
+    3. every piece is copied straight into its final position.
+
+Lifetime: leaf pieces point at the original characters, so an expression must be converted to a String within the
+full expression that created it, like std::string_view. Do not store it in an auto variable.
+*/
+#include "StringClass.hpp"
+#include <type_traits>
+
+// Leaf: characters that already exist somewhere else (String, C-string, std::string)
+class StringPiece {
+    public:
+        StringPiece(const char *ptr, size_t len) : ptr(ptr), len(len) {}
+        size_t size() const { return len; }
+        char* writeTo(char *out) const {
+            myMemCpy(out, ptr, len);
+            return out + len;
+        }
+    private:
+        const char *ptr;
+        size_t len;
+};
+
+// Leaf: a single character, stored by value
+class CharPiece {
+    public:
+        explicit CharPiece(char c) : c(c) {}
+        size_t size() const { return 1; }
+        char* writeTo(char *out) const {
+            *out = c;
+            return out + 1;
+        }
+    private:
+        char c;
+};
+
+template <typename Left, typename Right>
+class StringConcat {
+    public:
+        StringConcat(const Left &lhs, const Right &rhs) : lhs(lhs), rhs(rhs), total(lhs.size() + rhs.size()) {}
+
+        size_t size() const { return total; } // O(1): computed while the expression was built
+
+        // Copies every piece, left to right, and returns the position after the last character
+        char* writeTo(char *out) const {
+            return rhs.writeTo(lhs.writeTo(out));
+        }
+
+        // Materializes the expression with exactly one allocation (none if the result fits inline)
+        String toString(std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const {
+            String result(total, String::UninitializedTag{}, resource);
+            writeTo(result.data);
+            return result;
+        }
+
+        operator String() const { return toString(); }
+
+    private:
+        Left lhs;   // Sub-expressions are stored by value: they are only a few pointers and lengths
+        Right rhs;
+        size_t total;
+};
+
+/* Turning each operand type into a piece */
+inline StringPiece toStringPiece(const String &str){ return StringPiece(str.c_str(), str.getLength()); }
+inline StringPiece toStringPiece(const char *str){ return StringPiece(str ? str : "", str ? std::strlen(str) : 0); }
+inline StringPiece toStringPiece(const std::string &str){ return StringPiece(str.data(), str.size()); }
+inline StringPiece toStringPiece(StringView view){ return StringPiece(view.data(), view.size()); }
+inline CharPiece toStringPiece(char c){ return CharPiece(c); }
+template <typename Left, typename Right>
+inline const StringConcat<Left, Right>& toStringPiece(const StringConcat<Left, Right> &expression){ return expression; }
+
+/*
+operator+ is only enabled when at least one side is a String or a StringConcat, so it never hijacks
+"a" + 'b' or std::string + std::string.
+*/
+template <typename T> struct IsStringExpression : std::false_type {};
+template <> struct IsStringExpression<String> : std::true_type {};
+template <typename Left, typename Right> struct IsStringExpression<StringConcat<Left, Right>> : std::true_type {};
+
+template <typename A, typename B,
+          typename = std::enable_if_t<IsStringExpression<std::decay_t<A>>::value || IsStringExpression<std::decay_t<B>>::value>>
+inline auto operator+(const A &lhs, const B &rhs){
+    using LeftPiece = std::decay_t<decltype(toStringPiece(lhs))>;
+    using RightPiece = std::decay_t<decltype(toStringPiece(rhs))>;
+    return StringConcat<LeftPiece, RightPiece>(toStringPiece(lhs), toStringPiece(rhs));
+}
+
+template <typename Left, typename Right>
+String& String::operator+=(const StringConcat<Left, Right> &expression){
+    appendWith(expression.size(), [&](char *out){ expression.writeTo(out); });
+    return *this;
+}
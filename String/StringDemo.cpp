@@ -0,0 +1,843 @@
+/*
+Demo program for the String class (String/StringClass.hpp).
+Build: g++ -std=c++20 String/StringDemo.cpp String/StringClass.cpp String/StringBuilder.cpp String/InternTable.cpp String/MappedFile.cpp String/StringColumn.cpp String/StringSort.cpp instrumentation.cpp myMemCpy.cpp myMemMem.cpp myHash.cpp myCase.cpp myUtf8.cpp memoryResources.cpp String/StringIO.cpp String/SharedString.cpp -o stringDemo
+*/
+#include "StringClass.hpp"
+#include "StringBuilder.hpp"
+#include "InternTable.hpp"
+#include "MappedFile.hpp"
+#include "FixedString.hpp"
+#include "StringColumn.hpp"
+#include "StringSort.hpp"
+#include "StringIO.hpp"
+#include "SharedString.hpp"
+#include "../memoryResources.hpp"
+#include "../instrumentation.hpp"
+#include "../myStrLen.hpp"
+#include "../cpuFeatures.hpp"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <iterator>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+Counting global operator new/delete.
+Replacing the global allocation functions lets the demo observe how many heap allocations each String operation performs.
+This is how we verify that SSO really removes the malloc for short strings.
+*/
+static size_t allocationCount = 0;
+
+void* operator new(size_t size){
+    ++allocationCount;
+    if(void *p = std::malloc(size ? size : 1)){
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size){
+    return operator new(size);
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+void operator delete[](void *p, size_t) noexcept { std::free(p); }
+// std::pmr::new_delete_resource() uses the aligned forms, so they are counted as well
+void* operator new(size_t size, std::align_val_t alignment){
+    ++allocationCount;
+    size_t align = static_cast<size_t>(alignment);
+    if(void *p = std::aligned_alloc(align, (size + align - 1) / align * align)){
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size, std::align_val_t alignment){
+    return operator new(size, alignment);
+}
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, size_t, std::align_val_t) noexcept { std::free(p); }
+
+// Runs op and reports whether it performed the expected number of heap allocations
+template <typename Op>
+static void checkAllocations(const char *label, size_t expected, Op op){
+    size_t before = allocationCount;
+    op();
+    size_t performed = allocationCount - before;
+    std::cout << (performed == expected ? "[OK]     " : "[FAILED] ") << label
+              << " -> allocations: " << performed << " (expected " << expected << ")" << std::endl;
+}
+
+static void ssoDemo(){
+    std::cout << "\n--- SSO allocation counts ---" << std::endl;
+    const char *shortText = "metric.cpu.user";                    // 15 chars: inline
+    const char *edgeText = "abcdefghijklmnopqrstuvw";             // exactly localCapacity (23) chars: inline
+    const char *longText = "this string is longer than the inline buffer"; // heap
+
+    checkAllocations("default constructor", 0, []{ String s; });
+    checkAllocations("short C-string constructor", 0, [&]{ String s(shortText); });
+    checkAllocations("23-char C-string constructor", 0, [&]{ String s(edgeText); });
+    checkAllocations("long C-string constructor", 1, [&]{ String s(longText); });
+
+    String shortStr(shortText);
+    String longStr(longText);
+    checkAllocations("copy of short string", 0, [&]{ String s(shortStr); });
+    checkAllocations("copy of long string", 1, [&]{ String s(longStr); });
+    checkAllocations("move of short string", 0, [&]{ String src(shortText); String dst(std::move(src)); });
+    checkAllocations("move of long string (steals buffer)", 1, [&]{ String src(longText); String dst(std::move(src)); });
+    checkAllocations("copy assignment of short string", 0, [&]{ String s; s = shortStr; });
+
+    String a(shortText);
+    String b(longText);
+    a.swap(b);
+    std::cout << "after swap a: " << a.c_str() << " (small: " << a.isSmall() << "), b: " << b.c_str()
+              << " (small: " << b.isSmall() << ")" << std::endl;
+}
+
+static void memoryResourceDemo(){
+    std::cout << "\n--- Memory resources ---" << std::endl;
+    const char *longText = "request-scoped string that does not fit inline";
+
+    // Arena: after the first request has reserved its chunk, later requests allocate nothing from the system
+    ArenaResource arena;
+    auto request = [&]{
+        for(int i = 0; i < 1000; i++){
+            String s(longText, &arena);
+            String copy(s, &arena);
+        }
+        arena.reset(); // End of request: every string above is freed in O(1)
+    };
+    request(); // Warm-up: reserves the arena chunks
+    checkAllocations("1000 long strings + copies in a reset arena", 0, request);
+    std::cout << "arena reserved bytes: " << arena.bytesReserved() << std::endl;
+
+    // Pool: blocks freed by one string are reused by the next one of the same size class
+    SizeClassPoolResource pool;
+    { String warmUp(longText, &pool); }
+    checkAllocations("1000 long strings from a size-class pool", 0, [&]{
+        for(int i = 0; i < 1000; i++){
+            String s(longText, &pool);
+        }
+    });
+
+    // Assignment keeps the target's resource: the characters are copied into the arena
+    String inArena("x", &arena);
+    String onHeap(longText);
+    inArena = onHeap;
+    std::cout << "assigned string stays in arena: " << (inArena.getResource() == &arena ? "yes" : "no") << std::endl;
+}
+
+static void concatenationDemo(){
+    std::cout << "\n--- Concatenation ---" << std::endl;
+    String host("metrics.example.internal");
+    String port("9090");
+    String path("api/v1/query_range");
+    std::string scheme = "https";
+
+    String url = scheme + String("://") + host + ':' + port + "/" + path;
+    std::cout << "url: " << url.c_str() << " Length: " << url.getLength() << std::endl;
+
+    checkAllocations("a + \"/\" + b + \":\" + c (long result)", 1, [&]{ String s = host + "/" + path + ":" + port; });
+    checkAllocations("a + \":\" + b (short result, inline)", 0, [&]{ String s = port + ":" + port; });
+
+    String greeting("Hello");
+    greeting += ", ";
+    greeting += String("World");
+    greeting += '!';
+    greeting += greeting; // Self-append reads the old characters before the buffer is replaced
+    std::cout << "greeting: " << greeting.c_str() << std::endl;
+
+    StringBuilder builder;
+    builder.reserve(128);
+    checkAllocations("StringBuilder append x4 after reserve", 0, [&]{
+        builder.append("GET /").append(path).append(' ').append(std::string("HTTP/1.1"));
+    });
+    String request;
+    checkAllocations("StringBuilder::take() (adopts buffer)", 0, [&]{ request = builder.take(); });
+    std::cout << "request: " << request.c_str() << std::endl;
+
+    // Appending the builder's own characters: the source is rebased when the buffer grows
+    StringBuilder doubling;
+    doubling.append("0123456789");
+    for(int i = 0; i < 4; i++) doubling.append(doubling.data(), doubling.size());
+    String doubled = doubling.take();
+    bool selfAppendOk = doubled.getLength() == 160 && doubled.view().substr(150) == "0123456789";
+    std::cout << "StringBuilder self-append: " << (selfAppendOk ? "yes" : "NO") << std::endl;
+}
+
+static void internDemo(){
+    std::cout << "\n--- Interning ---" << std::endl;
+    InternedString a = intern("http.server.requests.total");
+    InternedString b = intern(String("http.server.requests.total"));
+    InternedString c = intern("http.server.requests.failed");
+    std::cout << "a == b: " << (a == b) << " (same pointer: " << (a.c_str() == b.c_str()) << "), a == c: " << (a == c) << std::endl;
+    std::cout << "a: " << a.c_str() << " id: " << a.id() << ", c id: " << c.id() << std::endl;
+    checkAllocations("re-interning a known name", 0, []{ intern("http.server.requests.total"); });
+}
+
+/*
+Randomized check of find/rfind/count against std::string on a 2-letter alphabet: lots of partial matches, which
+exercises the vector filter, its verification step and the Two-Way fallback.
+*/
+static bool searchMatchesStdString(){
+    std::mt19937 rng(7);
+    for(int round = 0; round < 3000; round++){
+        std::string haystack(rng() % 300, 'a');
+        for(char &c : haystack) c = static_cast<char>('a' + rng() % 2);
+        std::string needle(1 + rng() % 12, 'a');
+        for(char &c : needle) c = static_cast<char>('a' + rng() % 2);
+        String text(haystack.c_str());
+        size_t expectedCount = 0;
+        for(size_t pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + needle.size())){
+            expectedCount++;
+        }
+        if(text.find(needle.c_str()) != haystack.find(needle) || text.rfind(needle.c_str()) != haystack.rfind(needle)
+           || text.count(needle.c_str()) != expectedCount){
+            std::cout << "search mismatch: needle " << needle << " in " << haystack << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+static void searchDemo(){
+    std::cout << "\n--- Search ---" << std::endl;
+    String log("GET /index.html 200; GET /about.html 404; POST /login 200");
+    std::cout << "find(\"GET\"): " << log.find("GET") << ", rfind(\"GET\"): " << log.rfind("GET")
+              << ", findFirstOf(\"0123456789\"): " << log.findFirstOf("0123456789")
+              << ", count(\"200\"): " << log.count("200") << ", contains(\"PUT\"): " << log.contains("PUT") << std::endl;
+    checkAllocations("replaceAll with equal lengths (in place)", 0, [&]{ log.replaceAll("GET", "PUT"); });
+    checkAllocations("replaceAll with different lengths (one allocation)", 1, [&]{ log.replaceAll("PUT", "DELETE"); });
+    std::cout << "after replaceAll: " << log.c_str() << std::endl;
+    std::cout << "search agrees with std::string: " << (searchMatchesStdString() ? "yes" : "NO") << std::endl;
+}
+
+/*
+Parses a generated access log through a memory mapping: every line and field is a StringView into the mapping, so
+the whole parse performs no allocation. Only the value kept after the file is closed is materialized as a String.
+The lines are also checked against std::getline (with "\r\n" endings and a last line without a terminator).
+*/
+static void mappedFileDemo(){
+    std::cout << "\n--- Memory-mapped parsing ---" << std::endl;
+    const char *path = "stringDemo_access.log";
+    std::string content;
+    for(int i = 0; i < 2000; i++){
+        content += (i % 3 ? "GET /page/" : "POST /api/v1/login/") + std::to_string(i) + (i % 7 ? " 200" : " 404") + (i % 5 ? "\n" : "\r\n");
+    }
+    content += "GET /last-line-without-newline 200";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << content;
+    }
+
+    String longestTarget;
+    {
+        MappedFile file(path);
+        size_t lines = 0, notFound = 0, longestPath = 0;
+        StringView longest;
+        checkAllocations("parsing 2001 mapped lines into fields", 0, [&]{
+            for(StringView line : file.lines()){
+                lines++;
+                StringView method = line.takeUntil(' ');
+                StringView target = line.takeUntil(' ');
+                if(line == "404"){
+                    notFound++;
+                }
+                if(method == "POST" && target.size() > longestPath){
+                    longestPath = target.size();
+                    longest = target;
+                }
+            }
+        });
+        std::cout << "lines: " << lines << ", 404s: " << notFound << std::endl;
+        longestTarget = String(longest); // Must outlive the mapping
+        checkAllocations("materializing a short field", 0, [&]{ String kept(longest); });
+
+        std::istringstream reference(content);
+        std::string expectedLine;
+        LineRange range(file.view());
+        LineRange::Iterator it = range.begin();
+        bool linesAgree = true;
+        while(std::getline(reference, expectedLine)){
+            if(!expectedLine.empty() && expectedLine.back() == '\r'){
+                expectedLine.pop_back();
+            }
+            if(!(it != range.end()) || *it != StringView(expectedLine)){
+                linesAgree = false;
+                break;
+            }
+            ++it;
+        }
+        linesAgree = linesAgree && !(it != range.end());
+        std::cout << "lines agree with std::getline: " << (linesAgree ? "yes" : "NO") << std::endl;
+    }
+    std::remove(path);
+    std::cout << "longest POST target (kept after unmapping): " << longestTarget.c_str() << std::endl;
+}
+
+/*
+With -DSTRING_INSTRUMENTATION=ON this shows the counters catching an accidental copy: takesByValue(name) copies
+name, takesByValue(std::move(name)) moves it. Without the option the counters stay at zero.
+*/
+static size_t takesByValue(String value){ return value.getLength(); }
+
+static void instrumentationDemo(){
+    std::cout << "\n--- Instrumentation ---" << std::endl;
+    if(!instrumentationEnabled()){
+        std::cout << "disabled (configure with -DSTRING_INSTRUMENTATION=ON to count copies and moves)" << std::endl;
+        return;
+    }
+    resetInstrumentation();
+    String name("a name long enough to live on the heap");
+    takesByValue(name);            // copy
+    takesByValue(std::move(name)); // move
+    InstrumentationSnapshot snapshot = instrumentationSnapshot();
+    bool ok = snapshot[Counter::StringCopyConstructions] == 1 && snapshot[Counter::StringMoveConstructions] == 1
+              && snapshot[Counter::StringHeapAllocations] == 2;
+    std::cout << (ok ? "[OK]     " : "[FAILED] ") << "by-value call counted 1 copy, 1 move, 2 heap allocations" << std::endl;
+    dumpInstrumentation(std::cout);
+}
+
+/*
+Compile-time strings: everything checked with static_assert below is evaluated by the compiler, and the status
+table and the metric names exist in the binary as ready-made data, with no runtime construction.
+*/
+static_assert(myStrlen("compile time") == 12);
+static_assert(myStrCompare("apple", "banana") < 0 && myStrCmp("same", "same"));
+static_assert(StringView("key=value").find('=') == 3);
+
+template <FixedString Name>
+struct Metric {
+    static constexpr StringView name = Name.view(); // Points at the template parameter object: static storage
+    size_t value = 0;
+};
+
+struct StatusEntry {
+    FixedString<12> text;
+    int code;
+};
+static constexpr StatusEntry statusTable[] = {
+    {FixedString<12>("OK"), 200}, {FixedString<12>("Not Found"), 404}, {FixedString<12>("Bad Gateway"), 502},
+};
+
+constexpr int statusCode(StringView text){
+    for(const StatusEntry &entry : statusTable){
+        if(entry.text == text){
+            return entry.code;
+        }
+    }
+    return -1;
+}
+static_assert(statusCode("Not Found") == 404 && statusCode("Teapot") == -1);
+
+constexpr FixedString prefix = "http.";
+constexpr auto requestsName = prefix + "requests"_fs;
+static_assert(requestsName == "http.requests" && requestsName.size() == 13 && requestsName.capacity() == 13);
+static_assert("abc"_fs < "abd"_fs && FixedString("abc") == StringView("abc"));
+
+// Switch-on-string: the hashes of the case labels are compile-time constants
+static int methodId(StringView method){
+    switch(fixedHash(method)){
+        case fixedHash("GET"): return method == "GET" ? 1 : 0;
+        case fixedHash("POST"): return method == "POST" ? 2 : 0;
+        case fixedHash("DELETE"): return method == "DELETE" ? 3 : 0;
+        default: return 0;
+    }
+}
+
+static void fixedStringDemo(){
+    std::cout << "\n--- Compile-time strings ---" << std::endl;
+    Metric<"http.requests.total"> requests;
+    requests.value = 42;
+    std::cout << "metric " << requests.name.data() << " = " << requests.value << std::endl;
+    std::cout << "status 'Bad Gateway' -> " << statusCode("Bad Gateway") << ", method ids GET/POST/PUT -> "
+              << methodId("GET") << "/" << methodId("POST") << "/" << methodId("PUT") << std::endl;
+    InlineString<15> host;
+    checkAllocations("InlineString built at runtime", 0, [&]{ host.append("db-").append("replica").append('-').append('7'); });
+    checkAllocations("FixedString to String (fits inline)", 0, [&]{ String s = host.toString(); });
+    std::cout << "host: " << host.c_str() << " (" << host.size() << "/" << host.capacity() << ")" << std::endl;
+}
+
+/*
+A column of 10000 mixed-length rows checked against the same rows held as std::vector<String>: row access,
+lengths, equality and prefix filters (including lengths around the 8-row vector blocks), and the round trip.
+*/
+static void stringColumnDemo(){
+    std::cout << "\n--- StringColumn ---" << std::endl;
+    std::mt19937 rng(3);
+    std::vector<String> rows;
+    for(int i = 0; i < 10000; i++){
+        std::string text = i % 4 == 0 ? "GET" : (i % 4 == 1 ? "POST /api/" + std::to_string(rng() % 50) : std::string(rng() % 40, 'x'));
+        rows.emplace_back(text.c_str());
+    }
+    StringColumn column;
+    checkAllocations("bulk conversion from 10000 Strings", 2, [&]{ column = StringColumn::fromStrings(rows); });
+
+    bool ok = column.size() == rows.size();
+    std::vector<uint32_t> lengths(column.size());
+    column.lengths(lengths.data());
+    std::vector<uint32_t> expectedEqual, expectedPrefix;
+    for(size_t i = 0; ok && i < rows.size(); i++){
+        ok = column[i] == rows[i] && lengths[i] == rows[i].getLength();
+        if(rows[i] == "GET") expectedEqual.push_back(static_cast<uint32_t>(i));
+        if(rows[i].view().startsWith("POST /api/1")) expectedPrefix.push_back(static_cast<uint32_t>(i));
+    }
+    ok = ok && column.findEqual("GET") == expectedEqual && column.findPrefix("POST /api/1") == expectedPrefix;
+    std::vector<String> back = column.toStrings();
+    ok = ok && back.size() == rows.size() && back[1] == rows[1] && back[9999] == rows[9999];
+    std::vector<uint64_t> hashes(column.size());
+    column.hashes(hashes.data());
+    ok = ok && hashes[0] == hashes[4] && hashes[0] != hashes[1]; // rows 0 and 4 are both "GET"
+    std::cout << "column agrees with std::vector<String>: " << (ok ? "yes" : "NO") << " (" << column.size()
+              << " rows, " << column.byteSize() << " bytes of characters, " << expectedEqual.size() << " GET rows)" << std::endl;
+}
+
+/*
+sortStrings/sortCStrings against std::sort with byte-wise comparison: random strings, strings sharing a long prefix,
+duplicates, empty strings and embedded zero bytes, on one thread and (above the threshold) on four.
+*/
+static bool sortMatchesStdSort(size_t count, size_t threads){
+    std::mt19937 rng(static_cast<unsigned>(count));
+    std::vector<std::string> texts;
+    for(size_t i = 0; i < count; i++){
+        std::string text = i % 3 == 0 ? "https://example.com/api/v1/resource/" : "";
+        size_t length = rng() % 20;
+        for(size_t k = 0; k < length; k++){
+            text += static_cast<char>(i % 7 == 0 ? rng() % 3 : 'a' + rng() % 4); // rows with bytes 0..2 too
+        }
+        texts.push_back(text);
+    }
+    std::vector<String> strings;
+    for(const std::string &text : texts){
+        String value;
+        value += text;
+        strings.push_back(std::move(value));
+    }
+    sortStrings(strings, threads);
+    std::vector<std::string> expected = texts;
+    std::sort(expected.begin(), expected.end());
+    for(size_t i = 0; i < count; i++){
+        if(strings[i].view() != StringView(expected[i])){
+            return false;
+        }
+    }
+    // C-strings stop at the first zero byte, so compare them with strcmp semantics
+    std::vector<const char*> cstrings;
+    for(const std::string &text : texts){
+        cstrings.push_back(text.c_str());
+    }
+    std::vector<const char*> cexpected = cstrings;
+    std::sort(cexpected.begin(), cexpected.end(), [](const char *a, const char *b){ return std::strcmp(a, b) < 0; });
+    sortCStrings(cstrings.data(), cstrings.size(), threads);
+    for(size_t i = 0; i < count; i++){
+        if(std::strcmp(cstrings[i], cexpected[i]) != 0){
+            return false;
+        }
+    }
+    return true;
+}
+
+static void sortDemo(){
+    std::cout << "\n--- Sorting ---" << std::endl;
+    std::vector<String> names;
+    for(const char *name : {"pear", "apple", "fig", "apple pie", "", "banana split with extra chocolate", "banana"}){
+        names.emplace_back(name);
+    }
+    checkAllocations("sortStrings (entry array only, no String copies)", 1, [&]{ sortStrings(names); });
+    for(const String &name : names){
+        std::cout << "'" << name.c_str() << "' ";
+    }
+    std::cout << std::endl;
+    bool ok = sortMatchesStdSort(1000, 1) && sortMatchesStdSort(100000, 1) && sortMatchesStdSort(100000, 4);
+    // Strings sharing a 1 MiB prefix: the = part is followed for 128K passes without growing the stack
+    std::string prefix(size_t(1) << 20, 'p');
+    std::vector<std::string> longTexts;
+    for(int i = 0; i < 32; i++){
+        longTexts.push_back(prefix + std::to_string((i * 7) % 32));
+    }
+    std::vector<const char*> longPointers;
+    for(const std::string &text : longTexts){
+        longPointers.push_back(text.c_str());
+    }
+    sortCStrings(longPointers.data(), longPointers.size());
+    std::vector<const char*> longExpected = longPointers;
+    std::sort(longExpected.begin(), longExpected.end(), [](const char *a, const char *b){ return std::strcmp(a, b) < 0; });
+    ok = ok && longPointers == longExpected;
+    std::cout << "sorts agree with std::sort: " << (ok ? "yes" : "NO") << std::endl;
+}
+
+/*
+String as an unordered_map key: transparent lookups by C-string and StringView allocate nothing, the cached hash is
+reset by mutation, and String, StringView and StringColumn hashes agree. Also checks that the AVX2 and scalar
+long-input hash kernels give identical values.
+*/
+static void hashDemo(){
+    std::cout << "\n--- Hashing ---" << std::endl;
+    std::unordered_map<String, int, StringHash, StringEqual> status;
+    status.emplace(String("OK"), 200);
+    status.emplace(String("a reason phrase longer than the inline buffer"), 299);
+    int found = 0;
+    checkAllocations("find by C-string and by StringView", 0, [&]{
+        found = status.find("OK")->second + status.find(StringView("a reason phrase longer than the inline buffer"))->second;
+    });
+    String key("mutable key");
+    uint64_t before = key.hash();
+    key += "!";
+    bool ok = found == 499 && key.hash() != before && key.hash() == StringView("mutable key!").hash()
+              && std::hash<String>()(key) == std::hash<StringView>()(key.view());
+    StringColumn column;
+    column.append("mutable key!");
+    uint64_t columnHash = 0;
+    column.hashes(&columnHash);
+    ok = ok && columnHash == key.hash();
+    static unsigned char bytes[3000];
+    for(size_t i = 0; i < sizeof(bytes); i++) bytes[i] = static_cast<unsigned char>(i * 7 + (i >> 5));
+    // The batch kernel buckets rows by length class: every length 0..300, packed back to back, must match myHash
+    StringColumn lengths;
+    for(size_t length = 0; length <= 300; length++){
+        lengths.append(StringView(reinterpret_cast<const char*>(bytes) + length, length));
+    }
+    std::vector<uint64_t> rowHashes(lengths.size());
+    lengths.hashes(rowHashes.data());
+    for(size_t row = 0; row < lengths.size(); row++){
+        ok = ok && rowHashes[row] == lengths[row].hash();
+    }
+    for(size_t length = 129; ok && length <= sizeof(bytes); length += 37){
+        ok = myHashLongScalar(bytes, length, 0) == myHashLongAvx2(bytes, length, 0) || !cpuFeatures().avx2;
+    }
+    std::cout << "hash kernel: " << myHashKernelName() << ", cached/view/column hashes agree: " << (ok ? "yes" : "NO") << std::endl;
+}
+
+// Every length 0..100 and every offset into a buffer of all 256 byte values, against a per-byte std::tolower loop
+static bool caseMatchesScalar(){
+    static char bytes[356];
+    for(size_t i = 0; i < sizeof(bytes); i++) bytes[i] = static_cast<char>(i * 37 + 11);
+    for(size_t offset = 0; offset < 256; offset += 5){
+        for(size_t length = 0; length <= 100; length++){
+            const char *text = bytes + offset;
+            char lowered[100], upper[100];
+            myToLower(lowered, text, length);
+            myToUpper(upper, text, length);
+            for(size_t i = 0; i < length; i++){
+                unsigned char c = static_cast<unsigned char>(text[i]);
+                bool letter = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+                if(lowered[i] != static_cast<char>(letter ? std::tolower(c) : c) || upper[i] != static_cast<char>(letter ? std::toupper(c) : c)){
+                    return false;
+                }
+            }
+            if(!myEqualsIgnoreCase(lowered, length, upper, length) || myCompareIgnoreCase(upper, length, text, length) != 0){
+                return false;
+            }
+            if(length > 0 && (myMismatchIgnoreCase(text, lowered, length) != length || myHashIgnoreCase(upper, length) != myHash(lowered, length))){
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void caseDemo(){
+    std::cout << "\n--- Case conversion ---" << std::endl;
+    String header("Content-Type: Text/HTML; charset=UTF-8");
+    String lowered = header.toLowerCopy();
+    String shout("short ascii, ünïcode kept");
+    shout.toUpper();
+    std::cout << lowered.c_str() << " | " << shout.c_str() << std::endl;
+    std::unordered_map<String, int, StringHashIgnoreCase, StringEqualIgnoreCase> headers;
+    headers.emplace(String("Content-Length"), 1);
+    headers.emplace(String("X-Request-Identifier-For-Tracing"), 2);
+    int found = 0;
+    checkAllocations("case-insensitive header lookups", 0, [&]{
+        found = headers.find("content-length")->second + headers.find(StringView("x-request-identifier-for-TRACING"))->second;
+    });
+    bool ok = found == 3 && header.equalsIgnoreCase(lowered) && !header.equalsIgnoreCase("content-type")
+              && String("apple").compareIgnoreCase("BANANA") < 0 && String("Zeta").compareIgnoreCase("alpha") > 0
+              && String("abc").compareIgnoreCase("ABCD") < 0 && header.hashIgnoreCase() == lowered.hashIgnoreCase()
+              && caseMatchesScalar();
+    std::cout << "case kernel: " << myCaseKernelName() << ", matches scalar tolower/toupper: " << (ok ? "yes" : "NO") << std::endl;
+}
+
+static void utf8Demo(){
+    std::cout << "\n--- UTF-8 ---" << std::endl;
+    String text("na\xC3\xAFve caf\xC3\xA9 \xE6\x97\xA5\xE6\x9C\xAC \xF0\x9F\x8E\x89"); // naïve café 日本 🎉
+    String ascii("plain ascii text that lives on the heap");
+    std::u16string utf16 = text.toUtf16();
+    std::u32string utf32 = text.toUtf32();
+    String fromUtf16 = String::fromUtf16(utf16);
+    String fromUtf32 = String::fromUtf32(utf32);
+    std::cout << "bytes: " << text.getLength() << ", code points: " << text.codePointCount()
+              << ", UTF-16 units: " << utf16.size() << ", UTF-32 units: " << utf32.size() << std::endl;
+    bool ok = !text.isAscii() && text.isValidUtf8() && text.codePointCount() == 15 && utf16.size() == 16
+              && utf32.size() == 15 && utf32[14] == U'\U0001F389' && fromUtf16 == text && fromUtf32 == text
+              && ascii.isAscii() && ascii.codePointCount() == ascii.getLength();
+    text += "!";
+    ok = ok && text.codePointCount() == 16 && text.toUpper().codePointCount() == 16;
+    // Overlong '/', a UTF-16 surrogate, a truncated 4-byte sequence and a value above U+10FFFF
+    const char *malformed[] = {"\xC0\xAF", "\xED\xA0\x80", "abc\xF0\x9F\x8E", "\xF4\x90\x80\x80"};
+    for(const char *bytes : malformed){
+        String bad(bytes);
+        bool threw = false;
+        try{ bad.toUtf16(); }
+        catch(const std::invalid_argument&){ threw = true; }
+        ok = ok && !bad.isValidUtf8() && !StringView(bytes).isValidUtf8() && threw;
+    }
+    bool surrogateRejected = false;
+    try{ String::fromUtf16(u"\xD800 lone"); }
+    catch(const std::invalid_argument&){ surrogateRejected = true; }
+    std::cout << "validation kernel: " << myUtf8KernelName() << ", round trips and rejections: " << (ok && surrogateRejected ? "yes" : "NO") << std::endl;
+}
+
+static void capacityDemo(){
+    std::cout << "\n--- Capacity and growth ---" << std::endl;
+    // 23 -> 46 -> 92 -> ... -> 188416: the capacity doubles, so 100000 appends reallocate 13 times
+    String grown;
+    checkAllocations("100000 pushBack calls (geometric growth)", 13, [&]{
+        for(int i = 0; i < 100000; i++) grown.pushBack(static_cast<char>('a' + i % 26));
+    });
+    String reserved;
+    reserved.reserve(4096);
+    checkAllocations("4000 appends after reserve(4096)", 0, [&]{
+        for(int i = 0; i < 1000; i++) reserved.append("abcd", 4);
+    });
+    String source("a heap string that is moved, not copied");
+    String target("another heap string, its block is released");
+    checkAllocations("move assignment steals the heap block", 0, [&]{ target = std::move(source); });
+    checkAllocations("copy assignment into a large enough buffer", 0, [&]{ reserved = target; });
+    // Between resources the characters are copied and the source's pool block goes back to its own size class
+    SizeClassPoolResource pool;
+    String pooled("a heap string in a pool, moved into another resource", &pool);
+    String elsewhere("short");
+    elsewhere = std::move(pooled);
+    bool movedAcross = elsewhere == "a heap string in a pool, moved into another resource" && pooled.getLength() == 0
+                       && pooled.isSmall() && *pooled.c_str() == '\0' && pooled.getResource() == &pool;
+    pooled.append(elsewhere.view());
+    movedAcross = movedAcross && pooled == elsewhere;
+
+    String edited("hello world");
+    edited.insert(5, ",").insert(edited.getLength(), "!").erase(0, 1).insert(0, "H");
+    edited.append(3, '?');
+    edited.resize(edited.getLength() - 2);
+    uint64_t before = edited.hash();
+    edited[0] = 'J';
+    bool ok = edited == "Jello, world!?" && edited.hash() != before && source.getLength() == 0
+              && grown.getLength() == 100000 && grown.getCapacity() == 188416 && movedAcross;
+    grown.resize(10);
+    grown.shrinkToFit();
+    ok = ok && grown.isSmall() && grown == "abcdefghij";
+    // s += s and inserting a view of itself: the source is read before the buffer moves
+    String self("0123456789");
+    for(int i = 0; i < 3; i++) self += self;
+    self.insert(4, self.view().substr(0, 3));
+    ok = ok && self.getLength() == 83 && self.view().substr(0, 8) == "01230124";
+
+    // A ReallocResource grows large blocks with mremap: the pages are remapped, not copied
+    String log("", reallocResource());
+    char chunk[4096];
+    std::memset(chunk, 'x', sizeof(chunk));
+    for(int i = 0; i < 4096; i++) log.append(chunk, sizeof(chunk));
+    ok = ok && log.getLength() == (size_t(16) << 20) && log.view().find('y') == StringView::npos;
+    std::cout << "16 MiB appended through a ReallocResource, capacity " << (log.getCapacity() >> 20) << " MiB; "
+              << "edits, growth and self-appends: " << (ok ? "yes" : "NO") << std::endl;
+}
+
+static void ioDemo(){
+    std::cout << "\n--- Stream and file I/O ---" << std::endl;
+    std::istringstream input("alpha  beta\n\tgamma-delta-with-a-longer-tail " + std::string(600, 'z') + " ");
+    String word;
+    std::vector<size_t> lengths;
+    while(input >> word) lengths.push_back(word.getLength());
+    std::ostringstream echoed;
+    echoed << String(StringView("a\0b", 3));
+    const size_t expectedLengths[] = {5, 4, 30, 600};
+    bool ok = std::equal(lengths.begin(), lengths.end(), std::begin(expectedLengths), std::end(expectedLengths)) && input.eof() && echoed.str() == std::string("a\0b", 3);
+
+    const char *path = "stringDemo_io.tmp";
+    const size_t records = 20000;
+    String longLine(StringView(std::string(300, 'L')));
+    size_t syscalls = 0;
+    {
+        int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if(fd < 0){
+            std::cout << "cannot create " << path << std::endl;
+            return;
+        }
+        BatchWriter out(fd);
+        for(size_t i = 0; i < records; i++){
+            String id(StringView(std::to_string(i)));
+            out.write("record ").write(id).write(i % 1000 ? "\n" : "\r\n");
+            if(i % 5000 == 0){
+                out.writeBorrowed(longLine).write("\n"); // referenced, not copied: longLine outlives the flush
+            }
+            if(i % 5000 == 2500){
+                String lower = longLine.toLowerCopy(); // write() copies: lower is gone long before the flush
+                out.write(lower).write("\n");
+            }
+        }
+        out.write("last line without newline");
+        out.flush();
+        syscalls = out.syscalls();
+        ::close(fd);
+    }
+
+    // getline reuses the line's capacity: after the long lines no line allocates
+    LineReader reader(path, 4096);
+    String line;
+    size_t lines = 0, crlf = 0, longest = 0;
+    while(reader.getline(line)){
+        lines++;
+        crlf += line.getLength() > 0 && line[line.getLength() - 1] == '\r';
+        longest = std::max(longest, line.getLength());
+    }
+    ok = ok && lines == records + 8 + 1 && crlf == records / 1000 && longest == 300 && line == "last line without newline";
+
+    std::ifstream reference(path, std::ios::binary);
+    std::string expected((std::istreambuf_iterator<char>(reference)), std::istreambuf_iterator<char>());
+    String all = readFile(path);
+    ok = ok && all.view() == StringView(expected) && all.count(String(StringView(std::string(300, 'l')))) == records / 5000;
+    std::remove(path);
+    std::cout << lines << " lines (" << all.getLength() << " bytes) written with " << syscalls << " writev calls "
+              << "and read back with LineReader and readFile: " << (ok ? "yes" : "NO") << std::endl;
+}
+
+static void sharedStringDemo(){
+    std::cout << "\n--- Shared strings ---" << std::endl;
+    SharedString payload(StringView(std::string(4096, 'p')));
+    std::vector<SharedString> handedOut;
+    handedOut.reserve(16);
+    checkAllocations("16 copies of a 4 KiB SharedString", 0, [&]{
+        for(int i = 0; i < 16; i++) handedOut.push_back(payload);
+    });
+    bool ok = payload.useCount() == 17 && handedOut[15].c_str() == payload.c_str() && payload.hash() == String(payload.view()).hash();
+
+    // Copy-on-write: the writer gets its own block, every other holder keeps the original characters
+    SharedString edited = payload;
+    edited.append("!");
+    edited.mutableData()[0] = 'P';
+    ok = ok && payload.useCount() == 17 && edited.isUnique() && edited.getLength() == 4097 && payload[0] == 'p'
+         && handedOut[3] == payload && !(edited == payload);
+    handedOut.clear();
+    checkAllocations("append to the now unique payload (in place)", 0, [&]{ payload.assign("short"); payload.append(" and more"); });
+
+    // Readers poll a published value while a writer replaces it; each snapshot stays intact
+    AtomicSharedString config(SharedString(StringView("version=0")));
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> torn{0}, refreshes{0}, started{0};
+    std::vector<std::thread> readers;
+    for(int t = 0; t < 3; t++){
+        readers.emplace_back([&]{
+            SharedString current = config.load();
+            started.fetch_add(1, std::memory_order_release);
+            // The writer only starts once every reader holds "version=0", and each reader refreshes at least once
+            // even when stop is already set, so every reader sees a change however the threads are scheduled
+            do{
+                if(config.refresh(current)){
+                    refreshes.fetch_add(1, std::memory_order_relaxed);
+                    torn += !current.view().startsWith("version=");
+                }
+            } while(!stop.load(std::memory_order_acquire));
+        });
+    }
+    while(started.load(std::memory_order_acquire) < readers.size()){
+        std::this_thread::yield();
+    }
+    for(int version = 1; version <= 1000; version++){
+        config.store(SharedString(StringView("version=" + std::to_string(version))));
+        std::this_thread::yield(); // give the readers a chance to see intermediate versions
+    }
+    stop = true;
+    for(std::thread &reader : readers) reader.join();
+    SharedString expected = config.load();
+    bool swapped = config.compareExchange(expected, SharedString(StringView("stale"))) && config.load() == "stale";
+    ok = ok && torn == 0 && expected == SharedString(StringView("version=1000")) && swapped && payload == SharedString(StringView("short and more"));
+    ok = ok && refreshes.load() >= readers.size();
+    std::cout << "copies shared, copy-on-write, concurrent publication and compareExchange: " << (ok ? "yes" : "NO") << std::endl;
+}
+
+int main(){
+    //Example usage of the String class
+    String str1; // Default constructor
+    std::cout << "str1: "<<str1.c_str()<<" Length: "<<str1.getLength()<<std::endl;
+
+    String str2("Hello, World!"); //Passing string literal i.e. RO data/ // Constructor from C-style string
+    std::cout << "str2: "<<str2.c_str()<<" Length: "<<str2.getLength()<<std::endl;
+
+    String str3(str2);  // Copy Constructor
+    std::cout << "str3 (copy of str2): "<<str3.c_str()<<" Length: "<<str3.getLength()<<std::endl;
+
+    String str3_copy = str2;  // Copy Constructor via direct initialization
+    std::cout << "str3_copy (copy of str2 via direct initialization): "<<str3_copy.c_str()<<" Length: "<<str3_copy.getLength()<<std::endl;
+
+    String str4(nullptr); // Handle null pointer input
+    std::cout << "str4 (from nullptr): "<<str4.c_str()<<" Length: "<<str4.getLength()<<std::endl;
+
+    char array[] = "Sample C-Style String";
+    String str5(array); // Constructor from C-style string
+    std::cout << "str5: "<<str5.c_str()<<" Length: "<<str5.getLength()<<std::endl;
+
+    const char *array2 = array;
+    String str6(array2); // Constructor from C-style string
+    std::cout << "str6: "<<str6.c_str()<<" Length: "<<str6.getLength()<<std::endl;  
+
+    std::string str7 = "Reference std::string";
+    std::string &refStr = str7;
+    String str8(refStr.c_str()); // Copy Constructor using reference
+    std::cout << "str8 (copy of str2 via reference): "<<str8.c_str()<<" Length: "<<str8.getLength()<<std::endl;
+
+    String & str9 = str2; // Reference to existing String object
+    String str10(str9); // Copy Constructor using String reference
+    std::cout << "str10 (copy of str2 via String reference): "<<str10.c_str()<<" Length: "<<str10.getLength()<<std::endl;   
+
+    std::cout << "str3 == str10: " << (str3 == str10) << ", str3 == str5: " << (str3 == str5) << std::endl;
+
+    //Move Constructor
+    String str11(String("Temporary String")); // Move constructor
+    std::cout << "str11 (moved from temporary): "<<str11.c_str()<<" Length: "<<str11.getLength()<<std::endl;    
+    String str12(std::move(str2)); // Move constructor using std::move
+    std::cout << "str12 (moved from str2): "<<str12.c_str()<<" Length: "<<str12.getLength()<<std::endl;    
+    std::cout << "str2 after move: "<<str2.c_str()<<" Length: "<<str2.getLength()<<std::endl;
+
+    //Copy Assignment Operator
+    String str13;
+    str13 = str3; // Copy Assignment Operator
+    std::cout << "str13 (after copy assignment from str3): "<<str13.c_str()<<" Length: "<<str13.getLength()<<std::endl;
+
+    //Stream operators: << writes the characters, >> reads one whitespace-delimited word
+    std::cout << "str13 via operator<<: " << str13 << std::endl;
+    std::istringstream words("  first second");
+    String word;
+    words >> word;
+    std::cout << "first word via operator>>: " << word << std::endl;
+
+    ssoDemo();
+    memoryResourceDemo();
+    concatenationDemo();
+    internDemo();
+    searchDemo();
+    mappedFileDemo();
+    fixedStringDemo();
+    stringColumnDemo();
+    sortDemo();
+    hashDemo();
+    caseDemo();
+    utf8Demo();
+    capacityDemo();
+    ioDemo();
+    sharedStringDemo();
+    instrumentationDemo();
+
+    return 0;
+}
@@ -0,0 +1,237 @@
+#include "StringIO.hpp"
+#include "../myMemOps.hpp"
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    // read(2) retried on EINTR; returns the bytes read, 0 at end of input
+    size_t readSome(int fd, char *destination, size_t bytes){
+        while(true){
+            ssize_t got = ::read(fd, destination, bytes);
+            if(got >= 0){
+                return static_cast<size_t>(got);
+            }
+            if(errno != EINTR){
+                throw std::system_error(errno, std::generic_category(), "read");
+            }
+        }
+    }
+
+    int openForReading(const char *path){
+        int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if(fd < 0){
+            throw std::system_error(errno, std::generic_category(), std::string("open ") + path);
+        }
+        return fd;
+    }
+}
+
+LineReader::LineReader(const char *path, size_t bufferSize)
+    : fd(openForReading(path)), ownsFd(true), buffer(new char[bufferSize ? bufferSize : 1]), bufferSize(bufferSize ? bufferSize : 1) {
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL); // read-ahead, like MappedFile's MADV_SEQUENTIAL
+}
+
+LineReader::LineReader(int fd, size_t bufferSize)
+    : fd(fd), ownsFd(false), buffer(new char[bufferSize ? bufferSize : 1]), bufferSize(bufferSize ? bufferSize : 1) {}
+
+LineReader::~LineReader(){
+    if(ownsFd){
+        ::close(fd);
+    }
+}
+
+LineReader::LineReader(LineReader &&other) noexcept
+    : fd(other.fd), ownsFd(other.ownsFd), buffer(std::move(other.buffer)), bufferSize(other.bufferSize),
+      begin(other.begin), end(other.end), scanned(other.scanned), atEnd(other.atEnd) {
+    other.ownsFd = false;
+    other.begin = other.end = other.scanned = 0;
+    other.atEnd = true;
+}
+
+bool LineReader::refill(){
+    if(begin > 0){
+        std::memmove(buffer.get(), buffer.get() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+    }
+    else if(end == bufferSize){
+        // A line longer than the buffer: double it, keeping the partial line
+        std::unique_ptr<char[]> larger(new char[bufferSize * 2]);
+        std::memcpy(larger.get(), buffer.get(), end);
+        buffer = std::move(larger);
+        bufferSize *= 2;
+    }
+    size_t got = readSome(fd, buffer.get() + end, bufferSize - end);
+    end += got;
+    atEnd = got == 0;
+    return !atEnd;
+}
+
+bool LineReader::readLine(StringView &line, char delimiter){
+    while(true){
+        const char *start = buffer.get() + begin;
+        const char *hit = myMemChr(start + scanned, end - begin - scanned, delimiter);
+        if(hit != nullptr){
+            size_t lineLength = static_cast<size_t>(hit - start);
+            line = StringView(start, lineLength);
+            begin += lineLength + 1;
+            scanned = 0;
+            return true;
+        }
+        scanned = end - begin; // don't rescan these bytes after the refill
+        if(atEnd || !refill()){
+            if(begin == end){
+                return false;
+            }
+            line = StringView(buffer.get() + begin, end - begin); // last line without a delimiter
+            begin = end;
+            scanned = 0;
+            return true;
+        }
+    }
+}
+
+bool LineReader::getline(String &line, char delimiter){
+    StringView view;
+    if(!readLine(view, delimiter)){
+        return false;
+    }
+    line.clear();
+    line.append(view);
+    return true;
+}
+
+/*
+A regular file is read in place: fstat gives the size, the String is sized once and read(2) writes straight into its
+buffer. One more read confirms the end (the file may have grown); pipes and sockets, which report no size, grow the
+buffer geometrically.
+*/
+String readAll(int fd, std::pmr::memory_resource *resource){
+    struct stat info;
+    if(::fstat(fd, &info) != 0){
+        throw std::system_error(errno, std::generic_category(), "fstat");
+    }
+    size_t expected = S_ISREG(info.st_mode) ? static_cast<size_t>(info.st_size) : 0;
+    size_t target = expected > 0 ? expected + 1 : size_t(64) << 10; // + 1: room for the read that sees the end
+    String result(StringView(), resource);
+    while(true){
+        size_t length = result.getLength();
+        if(length == target){
+            target *= 2;
+        }
+        bool done = false;
+        result.resizeAndOverwrite(target, [&](char *buffer, size_t count){
+            size_t got = readSome(fd, buffer + length, count - length);
+            done = got == 0;
+            return length + got;
+        });
+        if(done){
+            return result;
+        }
+    }
+}
+
+String readFile(const char *path, std::pmr::memory_resource *resource){
+    int fd = openForReading(path);
+    try{
+        String result = readAll(fd, resource);
+        ::close(fd);
+        return result;
+    }
+    catch(...){
+        ::close(fd);
+        throw;
+    }
+}
+
+BatchWriter::BatchWriter(int fd, size_t stagingSize)
+    : fd(fd), staging(new char[stagingSize ? stagingSize : 1]), stagingSize(stagingSize ? stagingSize : 1) {
+    pieces.reserve(maxPieces);
+}
+
+BatchWriter::~BatchWriter(){
+    try{
+        flush();
+    }
+    catch(...){
+        // Destructors must not throw; call flush() explicitly to see write errors
+    }
+}
+
+BatchWriter& BatchWriter::write(StringView bytes){
+    if(bytes.empty()){
+        return *this;
+    }
+    if(bytes.size() > stagingSize){
+        // Too large to stage: queue it behind the pending pieces and write them all before the caller's bytes can go
+        if(pieces.size() == maxPieces){
+            flush();
+        }
+        pieces.push_back(iovec{const_cast<char*>(bytes.data()), bytes.size()});
+        pending += bytes.size();
+        flush();
+        return *this;
+    }
+    if(stagingSize - stagingUsed < bytes.size() || pieces.size() == maxPieces){
+        flush();
+    }
+    char *destination = staging.get() + stagingUsed;
+    std::memcpy(destination, bytes.data(), bytes.size());
+    stagingUsed += bytes.size();
+    pending += bytes.size();
+    // Extend the previous entry when it ends exactly where this copy starts
+    if(!pieces.empty() && static_cast<char*>(pieces.back().iov_base) + pieces.back().iov_len == destination){
+        pieces.back().iov_len += bytes.size();
+    }
+    else{
+        pieces.push_back(iovec{destination, bytes.size()});
+    }
+    return *this;
+}
+
+BatchWriter& BatchWriter::writeBorrowed(StringView bytes){
+    if(bytes.size() < copyThreshold){
+        return write(bytes); // an iovec entry per tiny piece would cost more than the copy
+    }
+    if(pieces.size() == maxPieces){
+        flush();
+    }
+    pieces.push_back(iovec{const_cast<char*>(bytes.data()), bytes.size()});
+    pending += bytes.size();
+    return *this;
+}
+
+// writev may write only part of the batch (pipes, sockets, signals): skip what was written and retry the rest
+void BatchWriter::flush(){
+    iovec *next = pieces.data();
+    size_t remaining = pieces.size();
+    while(remaining > 0){
+        ssize_t written = ::writev(fd, next, static_cast<int>(remaining));
+        ++writeCalls;
+        if(written < 0){
+            if(errno == EINTR){
+                continue;
+            }
+            int error = errno;
+            pieces.erase(pieces.begin(), pieces.begin() + (next - pieces.data())); // keep only what was not written
+            throw std::system_error(error, std::generic_category(), "writev");
+        }
+        size_t advance = static_cast<size_t>(written);
+        pending -= advance;
+        while(remaining > 0 && advance >= next->iov_len){
+            advance -= next->iov_len;
+            ++next;
+            --remaining;
+        }
+        if(remaining > 0){
+            next->iov_base = static_cast<char*>(next->iov_base) + advance;
+            next->iov_len -= advance;
+        }
+    }
+    pieces.clear();
+    stagingUsed = 0;
+}
@@ -0,0 +1,112 @@
+#pragma once
+/*
+Bulk I/O for String: line reading and whole-file reads with read(2), batched writes with writev(2).
+
+istream/ostream cost a virtual call, a sentry and locale checks per operation, and std::getline copies every line
+out of the stream buffer into a std::string one streambuf call at a time. For batch tools that read and write tens of
+millions of records the per-record overhead dominates, so these work on file descriptors directly:
+
+    LineReader in("records.tsv");              // 1 MiB read buffer, refilled with read(2)
+    String line;
+    while(in.getline(line)){ ... }             // copied into line's existing capacity: no allocation per line
+    StringView view;
+    while(in.readLine(view)){ ... }            // or zero-copy: a view into the read buffer
+
+    String all = readFile("config.json");      // fstat + one read(2) straight into the String's buffer
+
+    BatchWriter out(STDOUT_FILENO);
+    for(const String &record : records) out.write(record).write("\n");
+    out.flush();                               // one writev(2) per 1024 pieces instead of one write per piece
+
+Errors throw std::system_error carrying errno, like MappedFile.
+The stream operators (operator<< and operator>> for String) are declared in StringClass.hpp.
+*/
+#include "StringClass.hpp"
+#include <memory>
+#include <vector>
+#include <sys/uio.h>
+
+class LineReader {
+    public:
+        static constexpr size_t defaultBufferSize = size_t(1) << 20;
+
+        // Opens path for reading; the descriptor is closed by the destructor
+        explicit LineReader(const char *path, size_t bufferSize = defaultBufferSize);
+        // Reads from an already open descriptor (e.g. STDIN_FILENO), which stays open
+        explicit LineReader(int fd, size_t bufferSize = defaultBufferSize);
+        ~LineReader();
+
+        LineReader(LineReader &&other) noexcept;
+        LineReader(const LineReader&) = delete;
+        LineReader& operator=(const LineReader&) = delete;
+
+        /*
+        Next line without its delimiter, like std::getline ('\r' is kept). The last line does not need a delimiter.
+        readLine's view points into the read buffer and is valid until the next call; false at the end of the input.
+        A line longer than the buffer grows the buffer.
+        */
+        bool readLine(StringView &line, char delimiter = '\n');
+        bool getline(String &line, char delimiter = '\n');
+
+    private:
+        // Moves the unread bytes to the front (growing the buffer if it is full) and reads more; false at end of input
+        bool refill();
+
+        int fd;
+        bool ownsFd;
+        std::unique_ptr<char[]> buffer;
+        size_t bufferSize;
+        size_t begin = 0;   // first unread byte
+        size_t end = 0;     // one past the last byte read
+        size_t scanned = 0; // bytes after begin already known not to contain the delimiter
+        bool atEnd = false;
+};
+
+// Reads everything from fd (a regular file is sized with fstat and read in place; pipes grow geometrically)
+String readAll(int fd, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+String readFile(const char *path, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+/*
+Coalesces many writes into writev(2) calls.
+write() copies its bytes into a staging buffer (adjacent copies share one iovec entry), so any temporary may be
+passed; a piece larger than the whole staging buffer is written out before write() returns instead.
+writeBorrowed() queues pieces of copyThreshold bytes or more by pointer, without copying: their bytes must stay valid
+until the next flush(). Use it for buffers that outlive the writer.
+Flushes happen explicitly, when maxPieces entries are queued, when the staging buffer is full, and in the destructor
+(errors there are swallowed: call flush() to see them). Partial writes and EINTR are retried.
+*/
+class BatchWriter {
+    public:
+        static constexpr size_t maxPieces = 1024; // IOV_MAX on Linux
+        static constexpr size_t copyThreshold = 64;
+
+        explicit BatchWriter(int fd, size_t stagingSize = size_t(64) << 10);
+        ~BatchWriter();
+
+        BatchWriter(const BatchWriter&) = delete;
+        BatchWriter& operator=(const BatchWriter&) = delete;
+
+        BatchWriter& write(StringView bytes);
+        BatchWriter& write(const String &str) { return write(str.view()); }
+        // Temporary Strings are rejected by write and writeBorrowed alike, so switching a call site between the two
+        // can never start queueing a pointer into a String that is gone before the flush
+        BatchWriter& write(String&&) = delete;
+        BatchWriter& write(const char *str) { return write(StringView(str)); }
+        // No copy for pieces of copyThreshold bytes or more: bytes must stay valid until the next flush()
+        BatchWriter& writeBorrowed(StringView bytes);
+        BatchWriter& writeBorrowed(const String &str) { return writeBorrowed(str.view()); }
+        BatchWriter& writeBorrowed(String&&) = delete;
+        void flush();
+
+        size_t pendingBytes() const { return pending; }
+        size_t syscalls() const { return writeCalls; } // writev calls made so far
+
+    private:
+        int fd;
+        std::vector<iovec> pieces;
+        std::unique_ptr<char[]> staging;
+        size_t stagingSize;
+        size_t stagingUsed = 0;
+        size_t pending = 0;
+        size_t writeCalls = 0;
+};
@@ -0,0 +1,199 @@
+#include "StringSort.hpp"
+#include "../myStrLen.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <utility>
+
+struct SortEntry {
+    uint64_t key;     // bytes [depth, depth + 8) of the string, big-endian, zero-padded past the end
+    const char *ptr;
+    size_t length;
+    size_t index;     // position in the caller's array
+};
+
+static constexpr size_t insertionSortThreshold = 16;
+
+// Big-endian so that comparing keys as integers orders them like memcmp on the bytes
+static inline uint64_t loadKey(const char *ptr, size_t length, size_t depth){
+    uint64_t word = 0;
+    if(depth < length){
+        size_t available = length - depth;
+        std::memcpy(&word, ptr + depth, available < 8 ? available : 8);
+    }
+    return __builtin_bswap64(word);
+}
+
+static void loadKeys(SortEntry *entries, size_t n, size_t depth){
+    for(size_t i = 0; i < n; i++){
+        entries[i].key = loadKey(entries[i].ptr, entries[i].length, depth);
+    }
+}
+
+// Full order of two entries whose first depth bytes are known to be equal
+static inline bool lessFrom(const SortEntry &a, const SortEntry &b, size_t depth){
+    if(a.key != b.key){
+        return a.key < b.key;
+    }
+    return StringView(a.ptr + depth, a.length - depth).compare(StringView(b.ptr + depth, b.length - depth)) < 0;
+}
+
+static void insertionSort(SortEntry *entries, size_t n, size_t depth){
+    for(size_t i = 1; i < n; i++){
+        SortEntry current = entries[i];
+        size_t j = i;
+        while(j > 0 && lessFrom(current, entries[j - 1], depth)){
+            entries[j] = entries[j - 1];
+            j--;
+        }
+        entries[j] = current;
+    }
+}
+
+static inline uint64_t medianOfThree(uint64_t a, uint64_t b, uint64_t c){
+    if(a < b){
+        return b < c ? b : (a < c ? c : a);
+    }
+    return a < c ? a : (b < c ? c : b);
+}
+
+/*
+Tukey's ninther: the median of the medians of three spread-out samples.
+A plain median of first/middle/last is not enough here: the three-way partition below leaves an already sorted
+range rotated by one, and on a rotated range first/middle/last pick a pivot near the minimum, which turns sorted
+input quadratic-looking. Nine samples across the range stay close to the true median.
+*/
+static uint64_t choosePivot(const SortEntry *entries, size_t n){
+    size_t step = n / 8;
+    auto key = [&](size_t i){ return entries[i].key; };
+    return medianOfThree(medianOfThree(key(0), key(step), key(2 * step)),
+                         medianOfThree(key(3 * step), key(n / 2), key(5 * step)),
+                         medianOfThree(key(6 * step), key(7 * step), key(n - 1)));
+}
+
+/*
+Sorts entries whose first depth bytes are all equal and whose keys hold the bytes at depth.
+Each pass splits the range into the < part, the = part continuing at depth + 8 and the > part. The < part goes to a
+new thread while the budget allows; of the rest, the two smaller parts are sorted recursively and the loop continues
+on the largest. Every recursive call thus gets at most half of the range and the stack stays O(log n) deep, even when
+a long shared prefix keeps all strings in the = part for prefix / 8 passes.
+*/
+struct SortRange {
+    SortEntry *entries;
+    size_t n;
+    size_t depth;
+};
+
+static void multikeySort(SortEntry *entries, size_t n, size_t depth, size_t threads){
+    std::thread helper;
+    while(n > insertionSortThreshold){
+        uint64_t pivot = choosePivot(entries, n);
+        // Three-way partition (Dijkstra): [0, lt) < pivot, [lt, i) == pivot, (gt, n) > pivot
+        size_t lt = 0, i = 0, gt = n;
+        while(i < gt){
+            uint64_t key = entries[i].key;
+            if(key < pivot){
+                std::swap(entries[lt++], entries[i++]);
+            }
+            else if(key > pivot){
+                std::swap(entries[i], entries[--gt]);
+            }
+            else{
+                i++;
+            }
+        }
+
+        // Strings ending inside this key are complete: equal padded keys, so the shorter one is smaller
+        SortEntry *equal = entries + lt;
+        SortEntry *continuing = std::partition(equal, entries + gt, [&](const SortEntry &entry){ return entry.length <= depth + 8; });
+        std::sort(equal, continuing, [](const SortEntry &a, const SortEntry &b){ return a.length < b.length; });
+        size_t continuingCount = static_cast<size_t>(entries + gt - continuing);
+        if(continuingCount > 1){
+            loadKeys(continuing, continuingCount, depth + 8);
+        }
+
+        SortRange parts[3] = {{entries, lt, depth}, {continuing, continuingCount, depth + 8}, {entries + gt, n - gt, depth}};
+        if(threads > 1 && lt > parallelSortThreshold && !helper.joinable()){
+            size_t given = threads / 2;
+            helper = std::thread(multikeySort, entries, lt, depth, given);
+            threads -= given;
+            parts[0].n = 0;
+        }
+        size_t largest = 0;
+        for(size_t k = 1; k < 3; k++){
+            if(parts[k].n > parts[largest].n){
+                largest = k;
+            }
+        }
+        for(size_t k = 0; k < 3; k++){
+            if(k != largest && parts[k].n > 1){
+                multikeySort(parts[k].entries, parts[k].n, parts[k].depth, threads);
+            }
+        }
+        entries = parts[largest].entries;
+        n = parts[largest].n;
+        depth = parts[largest].depth;
+    }
+    insertionSort(entries, n, depth);
+    if(helper.joinable()){
+        helper.join();
+    }
+}
+
+static size_t resolveThreads(size_t threads, size_t count){
+    if(count < parallelSortThreshold){
+        return 1;
+    }
+    if(threads == 0){
+        threads = std::thread::hardware_concurrency();
+    }
+    return threads == 0 ? 1 : threads;
+}
+
+static void sortEntries(std::vector<SortEntry> &entries, size_t threads){
+    loadKeys(entries.data(), entries.size(), 0);
+    multikeySort(entries.data(), entries.size(), 0, resolveThreads(threads, entries.size()));
+}
+
+void sortStrings(String *strings, size_t count, size_t threads){
+    std::vector<SortEntry> entries(count);
+    for(size_t i = 0; i < count; i++){
+        entries[i] = SortEntry{0, strings[i].c_str(), strings[i].getLength(), i};
+    }
+    sortEntries(entries, threads);
+    /*
+    Apply the permutation in place: position i must receive the string that was at entries[i].index.
+    Each cycle of the permutation is walked once with swaps (entries[].index is reused as the "done" marker),
+    so every String is moved exactly once and nothing is allocated.
+    Short strings' entry pointers point into the String objects, but they are not dereferenced any more.
+    */
+    for(size_t start = 0; start < count; start++){
+        if(entries[start].index == start || entries[start].index == SIZE_MAX){
+            continue;
+        }
+        size_t current = start;
+        while(entries[current].index != start){
+            size_t source = entries[current].index;
+            strings[current].swap(strings[source]);
+            entries[current].index = SIZE_MAX;
+            current = source;
+        }
+        entries[current].index = SIZE_MAX;
+    }
+}
+
+void sortStrings(std::vector<String> &strings, size_t threads){
+    sortStrings(strings.data(), strings.size(), threads);
+}
+
+void sortCStrings(const char **strings, size_t count, size_t threads){
+    std::vector<SortEntry> entries(count);
+    for(size_t i = 0; i < count; i++){
+        entries[i] = SortEntry{0, strings[i], myStrlen(strings[i]), i};
+    }
+    sortEntries(entries, threads);
+    for(size_t i = 0; i < count; i++){
+        strings[i] = entries[i].ptr;
+    }
+}
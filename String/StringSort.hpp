@@ -0,0 +1,32 @@
+#pragma once
+/*
+Sorting arrays of strings (byte-wise order, like strcmp / String::view().compare).
+
+std::sort with strcmp does O(n log n) comparisons, and every comparison dereferences two string pointers: cache
+misses all the way down, and long shared prefixes (URLs, paths) are re-compared at every level.
+These sorts first build a compact array of entries, one per string:
+
+    | key: 8 bytes of the string at the current depth, big-endian | pointer | length | original index |
+
+and run a multikey quicksort on the keys:
+    - entries are partitioned into < = > the pivot key with integer compares on the contiguous entry array; no string
+      is dereferenced during partitioning,
+    - the "=" part shares 8 more bytes, so it is sorted again at depth + 8 with freshly loaded keys: every byte of
+      a shared prefix is looked at once per string, not once per comparison,
+    - strings that end inside the current key are complete and go first (ordered by length).
+Small ranges finish with an insertion sort. Finally the original array is permuted into order (Strings are
+exchanged with swap(), no allocation, no character copy).
+
+Above parallelSortThreshold entries the partitions are sorted on several threads (threads == 0: one per hardware
+thread). The sort is not stable; equal strings are indistinguishable anyway.
+*/
+#include "StringClass.hpp"
+#include <cstddef>
+#include <vector>
+
+void sortStrings(String *strings, size_t count, size_t threads = 0);
+void sortStrings(std::vector<String> &strings, size_t threads = 0);
+void sortCStrings(const char **strings, size_t count, size_t threads = 0);
+
+// Below this many strings a sort runs on the calling thread only
+constexpr size_t parallelSortThreshold = size_t(1) << 16;
@@ -0,0 +1,186 @@
+#pragma once
+/*
+Non-owning view of characters that live somewhere else: a pointer and a length, nothing more.
+
+Constructing a String always costs strlen + allocation + copy. When parsing, most tokens are only compared, hashed or
+converted to numbers and then thrown away, so copying them is wasted work. A StringView points straight into the
+source buffer (a memory-mapped file, a String, a std::string) and is copied by value like a pointer.
+Lifetime: the view is only valid while the characters it points at are. Materialize it with String(view) when the
+value must outlive its source.
+StringView is NOT null-terminated; use data() together with size().
+Construction, comparison and slicing are constexpr, so views of literals can be built and compared at compile time.
+*/
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include "../myCase.hpp"
+#include "../myHash.hpp"
+#include "../myMemMem.hpp"
+#include "../myMemOps.hpp"
+#include "../myStrLen.hpp"
+#include "../myUtf8.hpp"
+
+class StringView {
+    public:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        constexpr StringView() : ptr(""), len(0) {}
+        constexpr StringView(const char *str) : ptr(str ? str : ""), len(str ? myStrlen(str) : 0) {}
+        constexpr StringView(const char *str, size_t len) : ptr(str), len(len) {}
+        StringView(const std::string &str) : ptr(str.data()), len(str.size()) {}
+
+        constexpr const char* data() const { return ptr; }
+        constexpr size_t size() const { return len; }
+        constexpr bool empty() const { return len == 0; }
+        constexpr char operator[](size_t index) const { return ptr[index]; }
+        constexpr const char* begin() const { return ptr; }
+        constexpr const char* end() const { return ptr + len; }
+
+        // Characters [pos, pos + count), clamped to the end of the view
+        constexpr StringView substr(size_t pos, size_t count = npos) const {
+            if(pos > len){
+                pos = len;
+            }
+            return StringView(ptr + pos, count < len - pos ? count : len - pos);
+        }
+        constexpr void removePrefix(size_t n){ ptr += n; len -= n; }
+        constexpr void removeSuffix(size_t n){ len -= n; }
+
+        constexpr size_t find(char c, size_t pos = 0) const {
+            if(pos >= len){
+                return npos;
+            }
+            const char *hit = std::is_constant_evaluated() ? std::char_traits<char>::find(ptr + pos, len - pos, c) : myMemChr(ptr + pos, len - pos, c);
+            return hit ? static_cast<size_t>(hit - ptr) : npos;
+        }
+        size_t rfind(char c) const {
+            const char *hit = myMemRChr(ptr, len, c);
+            return hit ? static_cast<size_t>(hit - ptr) : npos;
+        }
+        // First character that is any of the characters in set
+        size_t findFirstOf(StringView set, size_t pos = 0) const {
+            if(pos >= len){
+                return npos;
+            }
+            const char *hit = myMemChrAny(ptr + pos, len - pos, set.ptr, set.len);
+            return hit ? static_cast<size_t>(hit - ptr) : npos;
+        }
+        size_t find(StringView needle, size_t pos = 0) const {
+            if(pos > len){
+                return npos;
+            }
+            const char *hit = myMemMem(ptr + pos, len - pos, needle.ptr, needle.len);
+            return hit ? static_cast<size_t>(hit - ptr) : npos;
+        }
+        size_t rfind(StringView needle) const {
+            const char *hit = myMemRMem(ptr, len, needle.ptr, needle.len);
+            return hit ? static_cast<size_t>(hit - ptr) : npos;
+        }
+        bool contains(StringView needle) const { return find(needle) != npos; }
+        constexpr bool startsWith(StringView prefix) const { return prefix.len <= len && compareBytes(ptr, prefix.ptr, prefix.len) == 0; }
+        constexpr bool endsWith(StringView suffix) const { return suffix.len <= len && compareBytes(ptr + len - suffix.len, suffix.ptr, suffix.len) == 0; }
+
+        /*
+        Field splitting without allocation: returns the characters before the first delimiter and advances the view
+        past that delimiter. When there is no delimiter the whole rest is returned and the view becomes empty.
+            StringView line = "GET,/index.html,200";
+            StringView method = line.takeUntil(',');   // "GET", line is now "/index.html,200"
+        */
+        constexpr StringView takeUntil(char delimiter){
+            size_t at = find(delimiter);
+            StringView field(ptr, at == npos ? len : at);
+            size_t consumed = at == npos ? len : at + 1;
+            ptr += consumed;
+            len -= consumed;
+            return field;
+        }
+
+        // Byte-wise three-way comparison (<0, 0, >0), like memcmp, with the shorter view first on a tie
+        constexpr int compare(StringView other) const {
+            size_t common = len < other.len ? len : other.len;
+            int result = compareBytes(ptr, other.ptr, common);
+            if(result != 0){
+                return result;
+            }
+            return len < other.len ? -1 : (len > other.len ? 1 : 0);
+        }
+
+        std::string toStdString() const { return std::string(ptr, len); }
+
+        // myHash of the characters; equal to String::hash() for a String with the same characters
+        uint64_t hash() const { return myHash(ptr, len); }
+
+        // ASCII case-insensitive variants (see myCase.hpp): no lowered copy is built
+        bool equalsIgnoreCase(StringView other) const { return myEqualsIgnoreCase(ptr, len, other.ptr, other.len); }
+        int compareIgnoreCase(StringView other) const { return myCompareIgnoreCase(ptr, len, other.ptr, other.len); }
+        uint64_t hashIgnoreCase() const { return myHashIgnoreCase(ptr, len); }
+
+        // UTF-8 checks (see myUtf8.hpp); String caches the same answers
+        bool isAscii() const { return myIsAscii(ptr, len); }
+        bool isValidUtf8() const { return myUtf8Validate(ptr, len); }
+        size_t codePointCount() const { return myUtf8CountCodePoints(ptr, len); }
+
+        // char_traits in constant expressions, the vectorized myMemCmp at runtime
+        static constexpr int compareBytes(const char *lhs, const char *rhs, size_t n){
+            return std::is_constant_evaluated() ? std::char_traits<char>::compare(lhs, rhs, n) : myMemCmp(lhs, rhs, n);
+        }
+
+    private:
+        const char *ptr;
+        size_t len;
+};
+
+// Lengths are compared first (O(1)), the characters only when the lengths match
+constexpr bool operator==(StringView lhs, StringView rhs){
+    return lhs.size() == rhs.size() && StringView::compareBytes(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+constexpr bool operator!=(StringView lhs, StringView rhs){ return !(lhs == rhs); }
+constexpr bool operator<(StringView lhs, StringView rhs){ return lhs.compare(rhs) < 0; }
+
+template <>
+struct std::hash<StringView> {
+    size_t operator()(StringView view) const { return view.hash(); }
+};
+
+/*
+Iterates over the lines of a text as StringViews, without copying. The line terminator ('\n', or "\r\n") is not
+part of the line. A final line without a terminator is still returned; a trailing terminator does not produce an
+extra empty line.
+    for(StringView line : LineRange(text)) { ... }
+*/
+class LineRange {
+    public:
+        class Iterator {
+            public:
+                Iterator(const char *cursor, const char *end) : cursor(cursor), end(end) { advance(); }
+                StringView operator*() const { return line; }
+                Iterator& operator++(){ advance(); return *this; }
+                bool operator!=(const Iterator &other) const { return done != other.done || cursor != other.cursor; }
+            private:
+                void advance(){
+                    if(cursor == end){
+                        done = true;
+                        return;
+                    }
+                    const char *newline = myMemChr(cursor, static_cast<size_t>(end - cursor), '\n');
+                    const char *lineEnd = newline ? newline : end;
+                    line = StringView(cursor, lineEnd - cursor);
+                    if(line.size() > 0 && line[line.size() - 1] == '\r'){
+                        line.removeSuffix(1);
+                    }
+                    cursor = newline ? newline + 1 : end;
+                }
+                const char *cursor;
+                const char *end;
+                StringView line;
+                bool done = false;
+        };
+
+        explicit LineRange(StringView text) : text(text) {}
+        Iterator begin() const { return Iterator(text.begin(), text.end()); }
+        Iterator end() const { return Iterator(text.end(), text.end()); }
+
+    private:
+        StringView text;
+};
@@ -0,0 +1,44 @@
+/*
+Replaces the global allocation functions for the bench binary so every case can report allocations per operation.
+The counter is atomic because some benchmarks run several threads.
+*/
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<size_t> allocations{0};
+
+size_t allocationCount(){
+    return allocations.load(std::memory_order_relaxed);
+}
+
+void* operator new(size_t size){
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if(void* p = std::malloc(size ? size : 1)){
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size){
+    return operator new(size);
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+// std::pmr::new_delete_resource() uses the aligned forms, so they are counted as well
+void* operator new(size_t size, std::align_val_t alignment){
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    size_t align = static_cast<size_t>(alignment);
+    if(void * p = std::aligned_alloc(align, (size + align - 1) / align * align)){
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size, std::align_val_t alignment){
+    return operator new(size, alignment);
+}
+void operator delete(void * p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void * p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void * p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void * p, size_t, std::align_val_t) noexcept { std::free(p); }
@@ -0,0 +1,55 @@
+#include "benchHarness.hpp"
+#include "../String/StringClass.hpp"
+#include "../memoryResources.hpp"
+#include <string>
+#include <vector>
+
+/*
+Synthetic request loop: one operation = one request that builds 256 strings of mixed lengths (half inline, half on
+the heap), keeps them alive until the end of the request, then drops them all.
+    - default resource : every heap string is a malloc + free
+    - arena            : strings are bump-allocated, the request ends with a single reset()
+    - size-class pool  : freed blocks go back to per-size free lists and are reused by the next request
+allocs/op shows how much malloc traffic each strategy leaves.
+*/
+static const size_t stringsPerRequest = 256;
+
+static std::vector<std::string> makeRequestPayload(){
+    std::vector<std::string> texts;
+    for(size_t i = 0; i < stringsPerRequest; i++){
+        texts.push_back(std::string(8 + (i * 37) % 120, static_cast<char>('a' + i % 26)));
+    }
+    return texts;
+}
+
+void benchAllocators(BenchRunner& runner){
+    if(!runner.wants("request")){
+        return;
+    }
+    std::vector<std::string> texts = makeRequestPayload();
+    size_t requestBytes = 0;
+    for(const std::string& text : texts){
+        requestBytes += text.size();
+    }
+
+    // Slots are allocated once; each request constructs strings into them in place and destroys them at the end
+    std::vector<unsigned char> slots(stringsPerRequest * sizeof(String));
+    String *strings = reinterpret_cast<String*>(slots.data());
+    auto runRequest = [&](std::pmr::memory_resource *resource){
+        for(size_t i = 0; i < stringsPerRequest; i++){
+            new (&strings[i]) String(texts[i].c_str(), resource);
+        }
+        doNotOptimize(strings[stringsPerRequest - 1].c_str()[0]);
+        for(size_t i = 0; i < stringsPerRequest; i++){
+            strings[i].~String();
+        }
+    };
+
+    runner.run("request", "default resource", "256 strings", requestBytes, [&]{ runRequest(std::pmr::get_default_resource()); });
+
+    ArenaResource arena;
+    runner.run("request", "arena", "256 strings", requestBytes, [&]{ runRequest(&arena); arena.reset(); });
+
+    SizeClassPoolResource pool;
+    runner.run("request", "size-class pool", "256 strings", requestBytes, [&]{ runRequest(&pool); });
+}
@@ -0,0 +1,72 @@
+#include "benchHarness.hpp"
+#include "../String/StringClass.hpp"
+#include "../memoryResources.hpp"
+#include <string>
+
+/*
+Building a string by appending, to show that append is amortized O(1): GB/s (bytes appended per ns) stays flat as
+the final size grows when the capacity grows geometrically, and falls with the size when every append reallocates.
+    - pushBack       : 1 byte per call, String vs std::string
+    - append 16 B    : 16-byte pieces, String vs std::string
+    - exact growth   : reserve(length + 16) before every append, i.e. what += did before growth was geometric
+                       (capped at 64 KiB: it is O(n^2))
+    - append 4 KiB   : 4 KiB pieces up to 64 MiB, default resource (allocate + copy) vs ReallocResource (mremap)
+*/
+void benchAppend(BenchRunner& runner){
+    if(!runner.wants("append")){
+        return;
+    }
+    const char piece[] = "0123456789abcdef";
+    for(size_t size : {size_t(1) << 10, size_t(64) << 10, size_t(1) << 20}){
+        if(size > runner.getOptions().maxSize){
+            continue;
+        }
+        runner.run("append", "String::pushBack", "1 B", size, [&]{
+            String s;
+            for(size_t i = 0; i < size; i++) s.pushBack('x');
+            doNotOptimize(s);
+        });
+        runner.run("append", "std::string::push_back", "1 B", size, [&]{
+            std::string s;
+            for(size_t i = 0; i < size; i++) s.push_back('x');
+            doNotOptimize(s);
+        });
+        runner.run("append", "String::append", "16 B", size, [&]{
+            String s;
+            for(size_t i = 0; i < size; i += 16) s.append(piece, 16);
+            doNotOptimize(s);
+        });
+        runner.run("append", "std::string::append", "16 B", size, [&]{
+            std::string s;
+            for(size_t i = 0; i < size; i += 16) s.append(piece, 16);
+            doNotOptimize(s);
+        });
+        if(size <= (size_t(64) << 10)){
+            runner.run("append", "String exact growth", "16 B", size, [&]{
+                String s;
+                for(size_t i = 0; i < size; i += 16){
+                    s.reserve(s.getLength() + 16);
+                    s.append(piece, 16);
+                }
+                doNotOptimize(s);
+            });
+        }
+    }
+
+    static char chunk[4096];
+    for(size_t size : {size_t(4) << 20, size_t(64) << 20}){
+        if(size > runner.getOptions().maxSize){
+            continue;
+        }
+        runner.run("append", "String default resource", "4 KiB", size, [&]{
+            String s;
+            for(size_t i = 0; i < size; i += sizeof(chunk)) s.append(chunk, sizeof(chunk));
+            doNotOptimize(s);
+        });
+        runner.run("append", "String ReallocResource", "4 KiB", size, [&]{
+            String s("", reallocResource());
+            for(size_t i = 0; i < size; i += sizeof(chunk)) s.append(chunk, sizeof(chunk));
+            doNotOptimize(s);
+        });
+    }
+}
@@ -0,0 +1,38 @@
+#include "benchHarness.hpp"
+#include "../myStrLen.hpp"
+#include <cstring>
+#include <vector>
+
+/*
+strlen/strcmp sweep: strings of every power-of-two length up to maxSize (capped at 1 MiB: longer C-strings are not a
+realistic workload), starting at offset 0 and at offset 1 to exercise the unaligned head handling.
+strcmp compares two equal strings, the worst case that has to scan both to the end.
+*/
+void benchCStrings(BenchRunner& runner){
+    size_t maxSize = runner.getOptions().maxSize;
+    if(maxSize > (size_t(1) << 20)){
+        maxSize = size_t(1) << 20;
+    }
+
+    for(size_t size : powerOfTwoSizes(maxSize)){
+        std::vector<char> first(size + 2, 'x'), second(size + 2, 'x');
+        for(size_t offset : {size_t(0), size_t(1)}){
+            const char* variant = offset ? "offset 1" : "aligned";
+            char* a = first.data() + offset;
+            char* b = second.data() + (1 - offset);
+            a[size] = '\0';
+            b[size] = '\0';
+            if(runner.wants("strlen")){
+                runner.run("strlen", "myStrlen", variant, size, [&]{ size_t n = myStrlen(a); doNotOptimize(n); });
+                runner.run("strlen", "myStrlenScalar", variant, size, [&]{ size_t n = myStrlenScalar(a); doNotOptimize(n); });
+                runner.run("strlen", "libc strlen", variant, size, [&]{ size_t n = std::strlen(a); doNotOptimize(n); doNotOptimize(a); });
+            }
+            if(runner.wants("strcmp")){
+                runner.run("strcmp", "myStrCompare", variant, size, [&]{ int r = myStrCompare(a, b); doNotOptimize(r); });
+                runner.run("strcmp", "libc strcmp", variant, size, [&]{ int r = std::strcmp(a, b); doNotOptimize(r); doNotOptimize(a); });
+            }
+            a[size] = 'x';
+            b[size] = 'x';
+        }
+    }
+}
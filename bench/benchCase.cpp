@@ -0,0 +1,46 @@
+#include "benchHarness.hpp"
+#include "../String/StringClass.hpp"
+#include "../myCase.hpp"
+#include <cctype>
+#include <random>
+#include <string>
+#include <strings.h>
+
+/*
+ASCII case conversion and case-insensitive comparison on 16 B, 1 KiB and 1 MiB of mixed-case text:
+    - toLower in place: myToLower vs the per-byte std::tolower loop it replaces,
+    - equalsIgnoreCase on equal-ignoring-case inputs (the whole input is compared) vs strncasecmp,
+    - hashIgnoreCase vs the usual "lower a copy, then hash it" with std::hash<std::string>.
+*/
+void benchCase(BenchRunner& runner){
+    if(!runner.wants("case")){
+        return;
+    }
+    std::mt19937 rng(3);
+    for(size_t size : {size_t(16), size_t(1) << 10, size_t(1) << 20}){
+        if(size > runner.getOptions().maxSize){
+            continue;
+        }
+        std::string mixed(size, 'a');
+        for(char &c : mixed) c = static_cast<char>((rng() & 1 ? 'A' : 'a') + rng() % 26);
+        std::string lowered = mixed;
+        for(char &c : lowered) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        std::string buffer = mixed;
+        String mixedString(mixed.c_str());
+
+        runner.run("case", "myToLower", "in place", size, [&]{ myToLower(buffer.data(), buffer.data(), size); doNotOptimize(buffer); });
+        runner.run("case", "std::tolower loop", "in place", size, [&]{
+            for(char &c : buffer) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            doNotOptimize(buffer);
+        });
+        runner.run("case", "String::equalsIgnoreCase", "equal", size, [&]{ bool equal = mixedString.equalsIgnoreCase(lowered); doNotOptimize(equal); });
+        runner.run("case", "strncasecmp", "equal", size, [&]{ int result = strncasecmp(mixed.data(), lowered.data(), size); doNotOptimize(result); });
+        runner.run("case", "String::hashIgnoreCase", "hash", size, [&]{ uint64_t h = mixedString.hashIgnoreCase(); doNotOptimize(h); });
+        runner.run("case", "lowered copy + std::hash", "hash", size, [&]{
+            std::string copy = mixed;
+            for(char &c : copy) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            size_t h = std::hash<std::string>()(copy);
+            doNotOptimize(h);
+        });
+    }
+}
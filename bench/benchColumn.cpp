@@ -0,0 +1,68 @@
+#include "benchHarness.hpp"
+#include "../String/StringColumn.hpp"
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+One million short rows (HTTP methods, paths, a few long user agents) held two ways:
+    - std::vector<String> : one object per row, a heap block per row longer than the SSO buffer
+    - StringColumn        : one blob + 32-bit offsets
+Measured per whole column: building it from String rows, and scans computing lengths, an equality filter, a prefix
+filter and row hashes (String::hash() caches, so the vector<String> row hashes each view to measure the first call).
+The size column is the number of character bytes scanned.
+*/
+void benchColumn(BenchRunner& runner){
+    if(!runner.wants("column")){
+        return;
+    }
+    const size_t rowCount = 1000000;
+    std::mt19937 rng(5);
+    std::vector<String> strings;
+    strings.reserve(rowCount);
+    for(size_t i = 0; i < rowCount; i++){
+        unsigned kind = rng() % 8;
+        std::string text = kind < 3 ? "GET" : kind < 4 ? "POST" : kind < 7 ? "/api/v1/items/" + std::to_string(rng() % 100000)
+                                                                            : "Mozilla/5.0 (X11; Linux x86_64) agent " + std::to_string(rng() % 100);
+        strings.emplace_back(text.c_str());
+    }
+    StringColumn column = StringColumn::fromStrings(strings);
+    const size_t bytes = column.byteSize();
+    std::vector<uint32_t> lengths(rowCount);
+    std::vector<uint64_t> hashes(rowCount);
+
+    runner.run("column", "StringColumn", "fromStrings", bytes, [&]{ StringColumn built = StringColumn::fromStrings(strings); doNotOptimize(built); });
+    runner.run("column", "vector<String>", "copy", bytes, [&]{ std::vector<String> copy(strings); doNotOptimize(copy); });
+
+    runner.run("column", "StringColumn", "lengths", bytes, [&]{ column.lengths(lengths.data()); doNotOptimize(lengths); });
+    runner.run("column", "vector<String>", "lengths", bytes, [&]{
+        for(size_t i = 0; i < rowCount; i++) lengths[i] = static_cast<uint32_t>(strings[i].getLength());
+        doNotOptimize(lengths);
+    });
+
+    runner.run("column", "StringColumn", "== \"POST\"", bytes, [&]{ std::vector<uint32_t> rows = column.findEqual("POST"); doNotOptimize(rows); });
+    runner.run("column", "vector<String>", "== \"POST\"", bytes, [&]{
+        std::vector<uint32_t> rows;
+        for(size_t i = 0; i < rowCount; i++) if(strings[i] == "POST") rows.push_back(static_cast<uint32_t>(i));
+        doNotOptimize(rows);
+    });
+
+    runner.run("column", "StringColumn", "startsWith", bytes, [&]{ std::vector<uint32_t> rows = column.findPrefix("/api/v1/items/9"); doNotOptimize(rows); });
+    runner.run("column", "vector<String>", "startsWith", bytes, [&]{
+        std::vector<uint32_t> rows;
+        for(size_t i = 0; i < rowCount; i++) if(strings[i].view().startsWith("/api/v1/items/9")) rows.push_back(static_cast<uint32_t>(i));
+        doNotOptimize(rows);
+    });
+
+    runner.run("column", "StringColumn", "hashes", bytes, [&]{ column.hashes(hashes.data()); doNotOptimize(hashes); });
+    runner.run("column", "vector<String>", "hashes (uncached)", bytes, [&]{
+        for(size_t i = 0; i < rowCount; i++) hashes[i] = strings[i].view().hash();
+        doNotOptimize(hashes);
+    });
+    runner.run("column", "vector<String>", "hashes (std::hash)", bytes, [&]{
+        for(size_t i = 0; i < rowCount; i++) hashes[i] = std::hash<std::string_view>()(std::string_view(strings[i].c_str(), strings[i].getLength()));
+        doNotOptimize(hashes);
+    });
+}
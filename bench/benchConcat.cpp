@@ -0,0 +1,38 @@
+#include "benchHarness.hpp"
+#include "../String/StringClass.hpp"
+#include "../String/StringBuilder.hpp"
+#include <string>
+
+/*
+Chained concatenation a + "/" + b + ":" + c for short (inline) and long (heap) results.
+    - String      : expression template, one allocation at most
+    - std::string : operator+ on rvalues reuses the left buffer but still reallocates as it grows
+    - StringBuilder: reserve(total) + appends + take(): one allocation for long results, none for short ones
+*/
+void benchConcat(BenchRunner& runner){
+    if(!runner.wants("concat")){
+        return;
+    }
+    struct Case { const char *label; size_t partLength; };
+    for(Case c : {Case{"short parts", 3}, Case{"long parts", 40}}){
+        std::string a(c.partLength, 'a'), b(c.partLength, 'b'), d(c.partLength, 'c');
+        String sa(a.c_str()), sb(b.c_str()), sd(d.c_str());
+        size_t total = 3 * c.partLength + 2;
+
+        runner.run("concat", "String +", c.label, total, [&]{
+            String result = sa + "/" + sb + ":" + sd;
+            doNotOptimize(result.c_str()[0]);
+        });
+        runner.run("concat", "std::string +", c.label, total, [&]{
+            std::string result = a + "/" + b + ":" + d;
+            doNotOptimize(result[0]);
+        });
+        StringBuilder builder;
+        runner.run("concat", "StringBuilder", c.label, total, [&]{
+            builder.reserve(total);
+            builder.append(sa).append('/').append(sb).append(':').append(sd);
+            String result = builder.take();
+            doNotOptimize(result.c_str()[0]);
+        });
+    }
+}
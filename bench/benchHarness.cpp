@@ -0,0 +1,58 @@
+#include "benchHarness.hpp"
+#include <cstdio>
+
+void BenchRunner::addResult(const BenchResult& result){
+    results.push_back(result);
+    // Printed as soon as a case finishes so long sweeps show progress
+    std::printf("%-14s %-22s %-18s %10s %14.2f %10.2f %10.2f\n", result.group.c_str(), result.name.c_str(),
+                result.variant.c_str(), humanSize(result.size).c_str(), result.nsPerOp, result.gbPerSec, result.allocsPerOp);
+    std::fflush(stdout);
+}
+
+static std::string jsonEscape(const std::string& text){
+    std::string escaped;
+    for(char c : text){
+        if(c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+bool BenchRunner::writeJson(const std::string& path) const {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if(!file){
+        return false;
+    }
+    std::fprintf(file, "[\n");
+    for(size_t i = 0; i < results.size(); i++){
+        const BenchResult& r = results[i];
+        std::fprintf(file, "  {\"group\": \"%s\", \"name\": \"%s\", \"variant\": \"%s\", \"size\": %zu, "
+                           "\"ns_per_op\": %.3f, \"gb_per_s\": %.3f, \"allocs_per_op\": %.3f}%s\n",
+                     jsonEscape(r.group).c_str(), jsonEscape(r.name).c_str(), jsonEscape(r.variant).c_str(), r.size,
+                     r.nsPerOp, r.gbPerSec, r.allocsPerOp, i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(file, "]\n");
+    return std::fclose(file) == 0;
+}
+
+std::vector<size_t> powerOfTwoSizes(size_t maxSize){
+    std::vector<size_t> sizes;
+    for(size_t size = 1; size <= maxSize; size *= 2){
+        sizes.push_back(size);
+    }
+    return sizes;
+}
+
+std::string humanSize(size_t bytes){
+    char text[32];
+    if(bytes >= (size_t(1) << 20) && bytes % (size_t(1) << 20) == 0){
+        std::snprintf(text, sizeof(text), "%zuM", bytes >> 20);
+    }
+    else if(bytes >= 1024 && bytes % 1024 == 0){
+        std::snprintf(text, sizeof(text), "%zuK", bytes >> 10);
+    }
+    else{
+        std::snprintf(text, sizeof(text), "%zu", bytes);
+    }
+    return text;
+}
@@ -0,0 +1,121 @@
+#pragma once
+/*
+Minimal, dependency-free benchmark harness used by the bench target.
+
+Each benchmark case is a callable that performs ONE operation. BenchRunner calibrates the number of iterations so
+that a measurement lasts at least minTime, then records:
+    - ns/op      : wall-clock nanoseconds per operation
+    - GB/s       : bytesPerOp / ns (1 byte per ns == 1 GB/s), 0 when the case does not process a byte count
+    - allocs/op  : global operator new calls per operation (see allocCounter.cpp)
+Results are printed as a table and can be written as JSON, so two commits can be compared with a plain diff.
+*/
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+size_t allocationCount(); // Defined in allocCounter.cpp, which replaces global operator new
+
+// Keeps the compiler from optimizing away a value or the memory it points to
+template <typename T>
+inline void doNotOptimize(const T& value){
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobberMemory(){
+    asm volatile("" : : : "memory");
+}
+
+struct BenchResult {
+    std::string group;     // e.g. "memcpy"
+    std::string name;      // implementation, e.g. "myMemCpy" or "libc memcpy"
+    std::string variant;   // case details, e.g. "align=1" or "overlap=forward"
+    size_t size = 0;       // bytes processed per operation (or element count)
+    double nsPerOp = 0;
+    double gbPerSec = 0;
+    double allocsPerOp = 0;
+};
+
+struct BenchOptions {
+    double minTimeSeconds = 0.05;
+    size_t maxSize = size_t(64) << 20; // 64 MiB
+    std::string filter;                // only run groups containing this substring
+    std::string jsonPath;              // write JSON results here when not empty
+};
+
+class BenchRunner {
+    public:
+        explicit BenchRunner(const BenchOptions& options) : options(options) {}
+
+        const BenchOptions& getOptions() const { return options; }
+
+        // true if the group is selected by --filter
+        bool wants(const std::string& group) const {
+            return options.filter.empty() || group.find(options.filter) != std::string::npos;
+        }
+
+        template <typename Op>
+        void run(const std::string& group, const std::string& name, const std::string& variant, size_t bytesPerOp, Op op){
+            op(); // Warm-up: page-faults, lazy dispatch, caches
+            size_t iterations = 1;
+            while(true){
+                size_t allocationsBefore = allocationCount();
+                auto start = std::chrono::steady_clock::now();
+                for(size_t i = 0; i < iterations; i++){
+                    op();
+                    clobberMemory();
+                }
+                double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                size_t allocations = allocationCount() - allocationsBefore;
+                if(elapsed >= options.minTimeSeconds || iterations >= (size_t(1) << 40)){
+                    BenchResult result;
+                    result.group = group;
+                    result.name = name;
+                    result.variant = variant;
+                    result.size = bytesPerOp;
+                    result.nsPerOp = elapsed * 1e9 / iterations;
+                    result.gbPerSec = bytesPerOp ? bytesPerOp / result.nsPerOp : 0;
+                    result.allocsPerOp = static_cast<double>(allocations) / iterations;
+                    addResult(result);
+                    return;
+                }
+                // Grow towards the target time without overshooting by more than ~2x
+                double scale = elapsed > 0 ? options.minTimeSeconds / elapsed : 100;
+                iterations = static_cast<size_t>(iterations * (scale > 100 ? 100 : (scale < 2 ? 2 : scale)));
+            }
+        }
+
+        // Records a measurement taken by the caller (e.g. multi-threaded cases that time themselves)
+        void addResult(const BenchResult& result);
+
+        const std::vector<BenchResult>& getResults() const { return results; }
+
+        bool writeJson(const std::string& path) const;
+
+    private:
+        BenchOptions options;
+        std::vector<BenchResult> results;
+};
+
+// Size sweep 1 B .. maxSize in powers of two
+std::vector<size_t> powerOfTwoSizes(size_t maxSize);
+std::string humanSize(size_t bytes);
+
+// Benchmark groups. Each one skips itself when not selected by --filter.
+void benchMemory(BenchRunner& runner);      // myMemCpy / myMemMove / myMemSet / myMemCmp / myMemChr vs libc
+void benchCStrings(BenchRunner& runner);    // myStrlen / myStrCompare vs libc
+void benchStringClass(BenchRunner& runner); // String vs std::string and the pre-SSO heap-only layout
+void benchAllocators(BenchRunner& runner);  // String in a request loop: default resource vs arena vs pool
+void benchConcat(BenchRunner& runner);      // a + "/" + b + ":" + c: String vs std::string vs StringBuilder
+void benchIntern(BenchRunner& runner);      // multi-threaded intern() throughput and handle equality
+void benchSearch(BenchRunner& runner);      // String::find vs std::string::find vs memmem
+void benchParallelCopy(BenchRunner& runner); // myMemCpyParallel bandwidth by thread count
+void benchParse(BenchRunner& runner);       // log parsing: MappedFile + StringView vs ifstream + getline
+void benchColumn(BenchRunner& runner);      // StringColumn vs std::vector<String>: build, lengths, filters, hashes
+void benchSort(BenchRunner& runner);        // sortStrings/sortCStrings vs std::sort
+void benchHash(BenchRunner& runner);        // myHash throughput and String-keyed unordered_map lookups
+void benchCase(BenchRunner& runner);        // toLower / equalsIgnoreCase / hashIgnoreCase vs tolower loops and strncasecmp
+void benchUtf8(BenchRunner& runner);        // UTF-8 validation, code point counting and transcoding
+void benchAppend(BenchRunner& runner);      // amortized append: geometric growth vs exact growth, mremap growth
+void benchIO(BenchRunner& runner);          // read(2) line reader and writev batch writer vs ifstream/ofstream
+void benchShared(BenchRunner& runner);      // SharedString copies and AtomicSharedString publication across threads
@@ -0,0 +1,67 @@
+#include "benchHarness.hpp"
+#include "../String/StringClass.hpp"
+#include "../myHash.hpp"
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/*
+Hashing:
+    - raw throughput of myHash vs std::hash<std::string_view> (libstdc++: murmur-style, 8 bytes per step), 8 B..64 KiB,
+    - lookup throughput with 100k keys of 20-60 characters (URL-like), 100k lookups per op:
+        unordered_map<std::string> probed with a std::string        (hashes on every lookup)
+        unordered_map<String> probed with the stored String keys     (hash cached after the first lookup)
+        unordered_map<String> probed with const char* / StringView   (transparent, no temporary String)
+*/
+void benchHash(BenchRunner& runner){
+    if(runner.wants("hash")){
+        size_t maxSize = runner.getOptions().maxSize < (size_t(64) << 10) ? runner.getOptions().maxSize : size_t(64) << 10;
+        std::string text(maxSize, 'x');
+        for(size_t i = 0; i < text.size(); i++) text[i] = static_cast<char>('a' + (i * 7) % 26);
+        for(size_t size : powerOfTwoSizes(maxSize)){
+            if(size < 8){
+                continue;
+            }
+            runner.run("hash", "myHash", "bytes", size, [&]{ uint64_t h = myHash(text.data(), size); doNotOptimize(h); });
+            runner.run("hash", "std::hash<string_view>", "bytes", size, [&]{ size_t h = std::hash<std::string_view>()(std::string_view(text.data(), size)); doNotOptimize(h); });
+        }
+    }
+
+    if(runner.wants("hash-lookup")){
+        const size_t keyCount = 100000;
+        std::vector<std::string> keys;
+        for(size_t i = 0; i < keyCount; i++){
+            keys.push_back("/api/v1/tenants/" + std::to_string(i * 7919 % 1000) + "/objects/" + std::to_string(i) + std::string(i % 24, 'z'));
+        }
+        std::unordered_map<std::string, size_t> stdMap;
+        std::unordered_map<String, size_t, StringHash, StringEqual> stringMap;
+        std::vector<String> stringKeys;
+        for(size_t i = 0; i < keyCount; i++){
+            stdMap.emplace(keys[i], i);
+            stringMap.emplace(String(keys[i].c_str()), i);
+            stringKeys.emplace_back(keys[i].c_str());
+        }
+        runner.run("hash-lookup", "unordered_map<std::string>", "std::string key", keyCount, [&]{
+            size_t sum = 0;
+            for(const std::string &key : keys) sum += stdMap.find(key)->second;
+            doNotOptimize(sum);
+        });
+        runner.run("hash-lookup", "unordered_map<String>", "String key (cached)", keyCount, [&]{
+            size_t sum = 0;
+            for(const String &key : stringKeys) sum += stringMap.find(key)->second;
+            doNotOptimize(sum);
+        });
+        runner.run("hash-lookup", "unordered_map<String>", "const char* key", keyCount, [&]{
+            size_t sum = 0;
+            for(const std::string &key : keys) sum += stringMap.find(key.c_str())->second;
+            doNotOptimize(sum);
+        });
+        runner.run("hash-lookup", "unordered_map<String>", "StringView key", keyCount, [&]{
+            size_t sum = 0;
+            for(const std::string &key : keys) sum += stringMap.find(StringView(key))->second;
+            doNotOptimize(sum);
+        });
+    }
+}
@@ -0,0 +1,111 @@
+#include "benchHarness.hpp"
+#include "../String/StringIO.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+Line-oriented file I/O on a file of ~40-byte records (up to maxSize, capped at 64 MiB), bytes per op = file size.
+Reading: count the bytes of every line.
+    - ifstream + std::getline     : the baseline, one std::string reused for every line
+    - LineReader::getline(String) : read(2) into a 1 MiB buffer, each line copied into a reused String
+    - LineReader::readLine(view)  : the same without the copy
+    - readFile                    : the whole file into one String (fstat + a single read)
+    - ifstream rdbuf -> string    : the usual whole-file idiom
+Writing: the same records written from prepared Strings.
+    - ofstream << record << '\n'  : through the stream buffer
+    - BatchWriter write           : records copied into the 64 KiB staging buffer, one writev per buffer
+    - BatchWriter writeBorrowed   : records of 64 bytes or more referenced by iovecs, one writev per 1024 pieces
+The file stays in the page cache, so this measures per-line overhead rather than disk speed.
+*/
+void benchIO(BenchRunner& runner){
+    if(!runner.wants("io")){
+        return;
+    }
+    size_t fileSize = runner.getOptions().maxSize < (size_t(64) << 20) ? runner.getOptions().maxSize : size_t(64) << 20;
+    const char *path = "bench_io.tmp";
+    std::vector<String> records;
+    size_t total = 0;
+    for(size_t i = 0; total < fileSize; i++){
+        String record(StringView("user-" + std::to_string(i * 7919 % 1000003) + "\tGET\t/items/" + std::to_string(i) + "\t200"));
+        total += record.getLength() + 1;
+        records.push_back(std::move(record));
+    }
+    {
+        std::ofstream out(path, std::ios::binary);
+        for(const String &record : records){
+            out << record << '\n';
+        }
+    }
+
+    runner.run("io", "ifstream + std::getline", "read lines", total, [&]{
+        std::ifstream in(path, std::ios::binary);
+        std::string line;
+        size_t bytes = 0;
+        while(std::getline(in, line)){
+            bytes += line.size();
+        }
+        doNotOptimize(bytes);
+    });
+    runner.run("io", "LineReader::getline String", "read lines", total, [&]{
+        LineReader in(path);
+        String line;
+        size_t bytes = 0;
+        while(in.getline(line)){
+            bytes += line.getLength();
+        }
+        doNotOptimize(bytes);
+    });
+    runner.run("io", "LineReader::readLine view", "read lines", total, [&]{
+        LineReader in(path);
+        StringView line;
+        size_t bytes = 0;
+        while(in.readLine(line)){
+            bytes += line.size();
+        }
+        doNotOptimize(bytes);
+    });
+    runner.run("io", "ifstream rdbuf -> string", "read file", total, [&]{
+        std::ifstream in(path, std::ios::binary);
+        std::ostringstream content;
+        content << in.rdbuf();
+        doNotOptimize(content.str().size());
+    });
+    runner.run("io", "readFile", "read file", total, [&]{
+        String content = readFile(path);
+        doNotOptimize(content.getLength());
+    });
+
+    runner.run("io", "ofstream <<", "write lines", total, [&]{
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        for(const String &record : records){
+            out << record << '\n';
+        }
+    });
+    runner.run("io", "BatchWriter", "write lines", total, [&]{
+        int fd = ::open(path, O_WRONLY | O_TRUNC | O_CLOEXEC);
+        {
+            BatchWriter out(fd);
+            for(const String &record : records){
+                out.write(record).write("\n");
+            }
+        }
+        ::close(fd);
+    });
+    runner.run("io", "BatchWriter", "borrowed lines", total, [&]{
+        int fd = ::open(path, O_WRONLY | O_TRUNC | O_CLOEXEC);
+        {
+            BatchWriter out(fd);
+            for(const String &record : records){
+                out.writeBorrowed(record).write("\n"); // records outlive the writer
+            }
+        }
+        ::close(fd);
+    });
+    std::remove(path);
+}
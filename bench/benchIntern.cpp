@@ -0,0 +1,88 @@
+#include "benchHarness.hpp"
+#include "../String/InternTable.hpp"
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/*
+Interning throughput: T threads each look up names from a working set of 4096 already-interned metric names
+(the steady state of a metrics pipeline). ns/op is wall time divided by the total number of lookups over all threads,
+so perfect scaling halves ns/op every time the thread count doubles.
+The baseline is the usual alternative: one std::mutex around a std::unordered_set<std::string>.
+
+Equality: comparing two equal 40-byte names through their handles vs. String == vs. strcmp.
+*/
+static const size_t nameCount = 4096;
+
+template <typename Lookup>
+static void runThreads(BenchRunner& runner, const char* name, size_t threads, size_t opsPerThread, Lookup lookup){
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for(size_t t = 0; t < threads; t++){
+        workers.emplace_back([&, t]{
+            size_t index = t * 977;
+            for(size_t i = 0; i < opsPerThread; i++){
+                index = (index + 1237) % nameCount; // Stride through the working set
+                lookup(index);
+            }
+        });
+    }
+    for(std::thread& worker : workers){
+        worker.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    BenchResult result;
+    result.group = "intern";
+    result.name = name;
+    result.variant = "threads=" + std::to_string(threads);
+    result.size = threads * opsPerThread;
+    result.nsPerOp = elapsed * 1e9 / (threads * opsPerThread);
+    runner.addResult(result);
+}
+
+void benchIntern(BenchRunner& runner){
+    if(!runner.wants("intern")){
+        return;
+    }
+    std::vector<std::string> names;
+    for(size_t i = 0; i < nameCount; i++){
+        names.push_back("service.metric." + std::to_string(i) + ".latency_seconds");
+    }
+    InternTable table;
+    std::unordered_set<std::string> lockedSet;
+    std::mutex lockedSetMutex;
+    for(const std::string& name : names){
+        table.intern(name.c_str(), name.size());
+        lockedSet.insert(name);
+    }
+
+    size_t opsPerThread = static_cast<size_t>(2000000 * (runner.getOptions().minTimeSeconds / 0.05));
+    size_t maxThreads = std::thread::hardware_concurrency();
+    if(maxThreads < 4){
+        maxThreads = 4;
+    }
+    for(size_t threads = 1; threads <= maxThreads; threads *= 2){
+        runThreads(runner, "InternTable", threads, opsPerThread, [&](size_t index){
+            InternedString handle = table.intern(names[index].c_str(), names[index].size());
+            doNotOptimize(handle);
+        });
+        runThreads(runner, "mutex+unordered_set", threads, opsPerThread, [&](size_t index){
+            std::lock_guard<std::mutex> lock(lockedSetMutex);
+            auto it = lockedSet.find(names[index]);
+            doNotOptimize(it);
+        });
+    }
+
+    std::string longName(40, 'm');
+    std::string sameName = longName;
+    InternedString first = table.intern(longName.c_str());
+    InternedString second = table.intern(sameName.c_str());
+    String firstString(longName.c_str()), secondString(sameName.c_str());
+    runner.run("intern", "handle ==", "equal 40 B", 0, [&]{ bool equal = first == second; doNotOptimize(equal); });
+    runner.run("intern", "String ==", "equal 40 B", 0, [&]{ bool equal = firstString == secondString; doNotOptimize(equal); });
+    runner.run("intern", "strcmp", "equal 40 B", 0, [&]{ bool equal = std::strcmp(longName.c_str(), sameName.c_str()) == 0; doNotOptimize(equal); });
+}
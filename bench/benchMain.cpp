@@ -0,0 +1,66 @@
+/*
+Benchmark suite for the string and memory primitives.
+Usage: bench [--quick] [--filter <group>] [--json <file>] [--min-time <seconds>] [--max-size <bytes>]
+    --quick    short measurements and sizes up to 1 MiB (smoke test)
+    --filter   only run groups whose name contains the given text (e.g. memcpy, strlen, String)
+    --json     also write the results as JSON, for diffing between commits
+*/
+#include "benchHarness.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+int main(int argc, char** argv){
+    BenchOptions options;
+    for(int i = 1; i < argc; i++){
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if(arg == "--quick"){
+            options.minTimeSeconds = 0.005;
+            options.maxSize = size_t(1) << 20;
+        }
+        else if(arg == "--filter" && hasValue){
+            options.filter = argv[++i];
+        }
+        else if(arg == "--json" && hasValue){
+            options.jsonPath = argv[++i];
+        }
+        else if(arg == "--min-time" && hasValue){
+            options.minTimeSeconds = std::atof(argv[++i]);
+        }
+        else if(arg == "--max-size" && hasValue){
+            options.maxSize = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else{
+            std::fprintf(stderr, "usage: %s [--quick] [--filter <group>] [--json <file>] [--min-time <s>] [--max-size <bytes>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    BenchRunner runner(options);
+    std::printf("%-14s %-22s %-18s %10s %14s %10s %10s\n", "group", "name", "variant", "size", "ns/op", "GB/s", "allocs/op");
+    benchMemory(runner);
+    benchCStrings(runner);
+    benchStringClass(runner);
+    benchAllocators(runner);
+    benchConcat(runner);
+    benchIntern(runner);
+    benchSearch(runner);
+    benchParallelCopy(runner);
+    benchParse(runner);
+    benchColumn(runner);
+    benchSort(runner);
+    benchHash(runner);
+    benchCase(runner);
+    benchUtf8(runner);
+    benchAppend(runner);
+    benchIO(runner);
+    benchShared(runner);
+
+    if(!options.jsonPath.empty() && !runner.writeJson(options.jsonPath)){
+        std::fprintf(stderr, "could not write %s\n", options.jsonPath.c_str());
+        return 1;
+    }
+    return 0;
+}
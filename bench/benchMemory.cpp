@@ -0,0 +1,93 @@
+#include "benchHarness.hpp"
+#include "../myMemCpy.hpp"
+#include "../myMemOps.hpp"
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+/*
+memcpy/memmove sweep: every power-of-two size from 1 B to maxSize,
+    - aligned buffers and misaligned ones (source +1, destination +3),
+    - overlapping moves where the destination is 8 bytes before (forward) or after (backward) the source.
+The same size sweep, aligned and at offset +1 (+3 for the second operand), runs the myMemOps kernels:
+    - memset, memcmp of two equal buffers (every byte is compared),
+    - memchr / memrchr for a byte that is absent (the whole buffer is scanned),
+    - myMemChrAny with 4 set bytes against std::string_view::find_first_of (libc has no length-bounded strpbrk).
+Each kernel runs next to its libc equivalent on the same buffers.
+*/
+void benchMemory(BenchRunner& runner){
+    const size_t maxSize = runner.getOptions().maxSize;
+    const size_t slack = 64;
+
+    if(runner.wants("memcpy")){
+        for(size_t size : powerOfTwoSizes(maxSize)){
+            std::vector<unsigned char> src(size + slack, 'a'), dst(size + slack, 'b');
+            struct Alignment { size_t srcOffset, dstOffset; const char* label; };
+            for(Alignment align : {Alignment{0, 0, "aligned"}, Alignment{1, 3, "src+1 dst+3"}}){
+                unsigned char* d = dst.data() + align.dstOffset;
+                const unsigned char* s = src.data() + align.srcOffset;
+                runner.run("memcpy", "myMemCpy", align.label, size, [&]{ myMemCpy(d, s, size); doNotOptimize(d); });
+                runner.run("memcpy", "libc memcpy", align.label, size, [&]{ std::memcpy(d, s, size); doNotOptimize(d); });
+            }
+        }
+    }
+
+    if(runner.wants("memmove")){
+        for(size_t size : powerOfTwoSizes(maxSize)){
+            if(size < 16){
+                continue;
+            }
+            std::vector<unsigned char> buffer(size + 2 * slack, 'a');
+            unsigned char* base = buffer.data() + slack;
+            struct Overlap { unsigned char* dst; const unsigned char* src; const char* label; };
+            for(Overlap overlap : {Overlap{base - 8, base, "overlap forward"}, Overlap{base + 8, base, "overlap backward"}}){
+                runner.run("memmove", "myMemMove", overlap.label, size, [&]{ myMemMove(overlap.dst, overlap.src, size); doNotOptimize(overlap.dst); });
+                runner.run("memmove", "libc memmove", overlap.label, size, [&]{ std::memmove(overlap.dst, overlap.src, size); doNotOptimize(overlap.dst); });
+            }
+        }
+    }
+
+    struct Offsets { size_t first, second; const char* label; };
+    const Offsets offsets[] = {{0, 0, "aligned"}, {1, 3, "+1 +3"}};
+
+    if(runner.wants("memset")){
+        for(size_t size : powerOfTwoSizes(maxSize)){
+            std::vector<unsigned char> dst(size + slack);
+            for(Offsets align : offsets){
+                unsigned char* d = dst.data() + align.first;
+                runner.run("memset", "myMemSet", align.label, size, [&]{ myMemSet(d, 'x', size); doNotOptimize(d); });
+                runner.run("memset", "libc memset", align.label, size, [&]{ std::memset(d, 'x', size); doNotOptimize(d); });
+            }
+        }
+    }
+
+    if(runner.wants("memcmp")){
+        for(size_t size : powerOfTwoSizes(maxSize)){
+            std::vector<unsigned char> a(size + slack, 'a'), b(size + slack, 'a');
+            for(Offsets align : offsets){
+                const unsigned char* x = a.data() + align.first;
+                const unsigned char* y = b.data() + align.second;
+                runner.run("memcmp", "myMemCmp", align.label, size, [&]{ int result = myMemCmp(x, y, size); doNotOptimize(result); });
+                runner.run("memcmp", "libc memcmp", align.label, size, [&]{ int result = std::memcmp(x, y, size); doNotOptimize(result); });
+            }
+        }
+    }
+
+    if(runner.wants("memchr")){
+        for(size_t size : powerOfTwoSizes(maxSize)){
+            std::vector<char> text(size + slack, 'a');
+            for(Offsets align : offsets){
+                const char* p = text.data() + align.first;
+                runner.run("memchr", "myMemChr", align.label, size, [&]{ const char* hit = myMemChr(p, size, 'z'); doNotOptimize(hit); });
+                runner.run("memchr", "libc memchr", align.label, size, [&]{ const void* hit = std::memchr(p, 'z', size); doNotOptimize(hit); });
+                runner.run("memchr", "myMemRChr", align.label, size, [&]{ const char* hit = myMemRChr(p, size, 'z'); doNotOptimize(hit); });
+                runner.run("memchr", "libc memrchr", align.label, size, [&]{ const void* hit = memrchr(p, 'z', size); doNotOptimize(hit); });
+                runner.run("memchr", "myMemChrAny 4", align.label, size, [&]{ const char* hit = myMemChrAny(p, size, ",;\t\n", 4); doNotOptimize(hit); });
+                runner.run("memchr", "string_view::find_first_of 4", align.label, size, [&]{
+                    size_t hit = std::string_view(p, size).find_first_of(",;\t\n");
+                    doNotOptimize(hit);
+                });
+            }
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#include "benchHarness.hpp"
+#include "../myMemCpy.hpp"
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+Bandwidth scaling of myMemCpyParallel at maxSize: 1, 2, 4, ... up to the hardware thread count, next to the
+single-thread myMemCpy and libc memcpy. Also an overlapping myMemMoveParallel shifting the buffer by a quarter of
+its length (round-based parallel path).
+*/
+void benchParallelCopy(BenchRunner& runner){
+    if(!runner.wants("memcpy-mt")){
+        return;
+    }
+    const size_t size = runner.getOptions().maxSize;
+    std::vector<unsigned char> src(size, 'a'), dst(size, 'b');
+    unsigned char* d = dst.data();
+    const unsigned char* s = src.data();
+    runner.run("memcpy-mt", "libc memcpy", "1 thread", size, [&]{ std::memcpy(d, s, size); doNotOptimize(d); });
+    runner.run("memcpy-mt", "myMemCpy", "1 thread", size, [&]{ myMemCpy(d, s, size); doNotOptimize(d); });
+
+    size_t hardwareThreads = std::thread::hardware_concurrency();
+    if(hardwareThreads == 0){
+        hardwareThreads = 1;
+    }
+    for(size_t threads = 1;; threads *= 2){
+        if(threads > hardwareThreads){
+            threads = hardwareThreads;
+        }
+        std::string label = std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+        runner.run("memcpy-mt", "myMemCpyParallel", label, size, [&]{ myMemCpyParallel(d, s, size, threads); doNotOptimize(d); });
+        if(threads == hardwareThreads){
+            break;
+        }
+    }
+
+    std::vector<unsigned char> buffer(size + size / 4, 'c');
+    unsigned char* base = buffer.data();
+    runner.run("memcpy-mt", "myMemMoveParallel", "overlap forward", size, [&]{ myMemMoveParallel(base, base + size / 4, size); doNotOptimize(base); });
+    runner.run("memcpy-mt", "libc memmove", "overlap forward", size, [&]{ std::memmove(base, base + size / 4, size); doNotOptimize(base); });
+}
@@ -0,0 +1,64 @@
+#include "benchHarness.hpp"
+#include "../String/MappedFile.hpp"
+#include "../String/StringClass.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+/*
+Parsing a log file of up to maxSize bytes (capped at 256 MiB): count the lines whose status field is "404".
+    - MappedFile + StringView : lines and fields are views into the mapping, no allocation, no read buffer
+    - ifstream + getline      : the classic loop, which copies every line into a std::string
+    - getline + String        : the same, then one String per line, as code built on String(const char*) does
+The file stays in the page cache between iterations, so this measures parsing cost rather than disk speed.
+*/
+void benchParse(BenchRunner& runner){
+    if(!runner.wants("parse")){
+        return;
+    }
+    size_t fileSize = runner.getOptions().maxSize < (size_t(256) << 20) ? runner.getOptions().maxSize : size_t(256) << 20;
+    const char *path = "bench_parse.tmp";
+    {
+        std::ofstream out(path, std::ios::binary);
+        std::string line;
+        for(size_t written = 0, i = 0; written < fileSize; written += line.size(), i++){
+            line = "GET /static/assets/page-" + std::to_string(i) + ".html HTTP/1.1 " + (i % 13 ? "200" : "404") + "\n";
+            out << line;
+        }
+    }
+
+    runner.run("parse", "mmap + StringView", "count 404", fileSize, [&]{
+        MappedFile file(path);
+        size_t notFound = 0;
+        for(StringView line : file.lines()){
+            if(line.endsWith(" 404")){
+                notFound++;
+            }
+        }
+        doNotOptimize(notFound);
+    });
+    runner.run("parse", "ifstream + getline", "count 404", fileSize, [&]{
+        std::ifstream in(path, std::ios::binary);
+        std::string line;
+        size_t notFound = 0;
+        while(std::getline(in, line)){
+            if(line.size() >= 4 && line.compare(line.size() - 4, 4, " 404") == 0){
+                notFound++;
+            }
+        }
+        doNotOptimize(notFound);
+    });
+    runner.run("parse", "getline + String", "count 404", fileSize, [&]{
+        std::ifstream in(path, std::ios::binary);
+        std::string line;
+        size_t notFound = 0;
+        while(std::getline(in, line)){
+            String value(line.c_str());
+            if(value.view().endsWith(" 404")){
+                notFound++;
+            }
+        }
+        doNotOptimize(notFound);
+    });
+    std::remove(path);
+}
@@ -0,0 +1,44 @@
+#include "benchHarness.hpp"
+#include "../String/StringClass.hpp"
+#include "../myMemMem.hpp"
+#include <cstring>
+#include <random>
+#include <string>
+
+/*
+Substring search on long haystacks (up to 1 MiB capped by maxSize):
+    - text   : random lowercase letters, needle absent, so the whole haystack is scanned
+    - worst  : haystack "aaaa...", needle "aaa...aba": first and last bytes match at every position and the
+               verification only fails near the end. A naive filter + memcmp is O(n * m) here; the Two-Way
+               fallback keeps String::find linear.
+Compared against std::string::find and glibc memmem.
+*/
+void benchSearch(BenchRunner& runner){
+    if(!runner.wants("search")){
+        return;
+    }
+    size_t haystackSize = runner.getOptions().maxSize < (size_t(1) << 20) ? runner.getOptions().maxSize : size_t(1) << 20;
+    std::mt19937 rng(1);
+    std::string text(haystackSize, 'a');
+    for(char &c : text) c = static_cast<char>('a' + rng() % 26);
+    std::string repetitive(haystackSize, 'a');
+
+    struct Case { const char *variant; const std::string *haystack; std::string needle; };
+    Case cases[] = {
+        {"text, needle 4", &text, "QxYz"},
+        {"text, needle 16", &text, "0123456789abcdef"},
+        {"text, needle 64", &text, std::string(63, 'q') + "!"},
+        {"worst, needle 64", &repetitive, std::string(62, 'a') + "ba"},
+    };
+    for(const Case &c : cases){
+        const std::string &haystack = *c.haystack;
+        String haystackString(haystack.c_str());
+        String needleString(c.needle.c_str());
+        runner.run("search", "String::find", c.variant, haystack.size(), [&]{ size_t pos = haystackString.find(needleString); doNotOptimize(pos); });
+        runner.run("search", "std::string::find", c.variant, haystack.size(), [&]{ size_t pos = haystack.find(c.needle); doNotOptimize(pos); });
+        runner.run("search", "libc memmem", c.variant, haystack.size(), [&]{
+            const void *hit = memmem(haystack.data(), haystack.size(), c.needle.data(), c.needle.size());
+            doNotOptimize(hit);
+        });
+    }
+}
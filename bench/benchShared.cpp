@@ -0,0 +1,115 @@
+#include "benchHarness.hpp"
+#include "../String/SharedString.hpp"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+Fan-out of one payload to T threads, each making and dropping copies of it (ns/op = wall time / total copies):
+    - String copy        : allocation + memcpy per copy
+    - SharedString copy  : one atomic increment and decrement on the shared block
+    - shared_ptr copy    : the same protocol through std::shared_ptr<const std::string>, for reference
+All threads hit the same reference count, so the SharedString rows also show what that cache line costs under
+contention as T grows.
+Publication: T-1 readers take a snapshot of a published config value while one thread replaces it.
+    - AtomicSharedString::load    : spin bit + reference count on every read
+    - AtomicSharedString::refresh : pointer compare while unchanged
+    - mutex + shared_ptr          : the usual lock around a std::shared_ptr
+*/
+template <typename Op>
+static void runShared(BenchRunner& runner, const char* name, const std::string& variant, size_t threads, size_t opsPerThread, Op op){
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for(size_t t = 0; t < threads; t++){
+        workers.emplace_back([&, t]{
+            for(size_t i = 0; i < opsPerThread; i++){
+                op(t);
+            }
+        });
+    }
+    for(std::thread& worker : workers){
+        worker.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    BenchResult result;
+    result.group = "shared";
+    result.name = name;
+    result.variant = variant + " threads=" + std::to_string(threads);
+    result.size = threads * opsPerThread;
+    result.nsPerOp = elapsed * 1e9 / (threads * opsPerThread);
+    runner.addResult(result);
+}
+
+void benchShared(BenchRunner& runner){
+    if(!runner.wants("shared")){
+        return;
+    }
+    size_t opsPerThread = static_cast<size_t>(500000 * (runner.getOptions().minTimeSeconds / 0.05));
+    size_t maxThreads = std::thread::hardware_concurrency();
+    if(maxThreads < 4){
+        maxThreads = 4;
+    }
+
+    for(size_t size : {size_t(64), size_t(4096)}){
+        std::string text(size, 's');
+        String string(StringView(text.data(), text.size()));
+        SharedString shared(string);
+        std::shared_ptr<const std::string> pointer = std::make_shared<const std::string>(text);
+        std::string variant = std::to_string(size) + " B";
+        for(size_t threads = 1; threads <= maxThreads; threads *= 2){
+            runShared(runner, "String copy", variant, threads, opsPerThread / 4, [&](size_t){
+                String copy(string);
+                doNotOptimize(copy);
+            });
+            runShared(runner, "SharedString copy", variant, threads, opsPerThread, [&](size_t){
+                SharedString copy(shared);
+                doNotOptimize(copy);
+            });
+            runShared(runner, "shared_ptr copy", variant, threads, opsPerThread, [&](size_t){
+                std::shared_ptr<const std::string> copy(pointer);
+                doNotOptimize(copy);
+            });
+        }
+    }
+
+    AtomicSharedString config(SharedString(StringView("mode=fast;limit=100")));
+    std::shared_ptr<const std::string> lockedConfig = std::make_shared<const std::string>("mode=fast;limit=100");
+    std::mutex configMutex;
+    // Thread 0 publishes a new value every 1024 operations; the others read
+    for(size_t threads = 2; threads <= maxThreads; threads *= 2){
+        runShared(runner, "AtomicSharedString::load", "publish", threads, opsPerThread, [&](size_t t){
+            thread_local size_t count = 0;
+            if(t == 0 && ++count % 1024 == 0){
+                config.store(SharedString(StringView("mode=fast;limit=101")));
+            }
+            SharedString current = config.load();
+            doNotOptimize(current);
+        });
+        runShared(runner, "AtomicSharedString::refresh", "publish", threads, opsPerThread, [&](size_t t){
+            thread_local size_t count = 0;
+            thread_local SharedString current;
+            if(t == 0 && ++count % 1024 == 0){
+                config.store(SharedString(StringView("mode=fast;limit=101")));
+            }
+            config.refresh(current);
+            doNotOptimize(current);
+        });
+        runShared(runner, "mutex + shared_ptr", "publish", threads, opsPerThread, [&](size_t t){
+            thread_local size_t count = 0;
+            if(t == 0 && ++count % 1024 == 0){
+                std::shared_ptr<const std::string> fresh = std::make_shared<const std::string>("mode=fast;limit=101");
+                std::lock_guard<std::mutex> lock(configMutex);
+                lockedConfig.swap(fresh);
+            }
+            std::shared_ptr<const std::string> current;
+            {
+                std::lock_guard<std::mutex> lock(configMutex);
+                current = lockedConfig;
+            }
+            doNotOptimize(current);
+        });
+    }
+}
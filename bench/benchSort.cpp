@@ -0,0 +1,68 @@
+#include "benchHarness.hpp"
+#include "../String/StringSort.hpp"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+Sorting 200k strings, three inputs:
+    - random        : 8..24 random lowercase letters
+    - shared prefix : "https://example.com/api/v1/users/" followed by a random id (the first 33 bytes never differ)
+    - sorted        : the random input, already in order
+C-string arrays: sortCStrings vs std::sort with strcmp. String arrays: sortStrings vs std::sort of the Strings
+(moved with the move constructor and move assignment) comparing views.
+Every op sorts a fresh copy of the input; the "copy only" rows show what that copy costs on its own.
+*/
+void benchSort(BenchRunner& runner){
+    if(!runner.wants("sort")){
+        return;
+    }
+    const size_t count = 200000;
+    std::mt19937 rng(9);
+    std::vector<std::string> random, sharedPrefix;
+    for(size_t i = 0; i < count; i++){
+        std::string text(8 + rng() % 17, 'a');
+        for(char &c : text) c = static_cast<char>('a' + rng() % 26);
+        random.push_back(text);
+        sharedPrefix.push_back("https://example.com/api/v1/users/" + std::to_string(rng() % 100000000));
+    }
+    std::vector<std::string> sorted = random;
+    std::sort(sorted.begin(), sorted.end());
+
+    struct Input { const char *label; const std::vector<std::string> *texts; };
+    for(Input input : {Input{"random", &random}, Input{"shared prefix", &sharedPrefix}, Input{"sorted", &sorted}}){
+        std::vector<const char*> cstrings;
+        std::vector<String> strings;
+        for(const std::string &text : *input.texts){
+            cstrings.push_back(text.c_str());
+            strings.emplace_back(text.c_str());
+        }
+        std::vector<const char*> cwork(count);
+        runner.run("sort", "sortCStrings", input.label, count, [&]{
+            cwork = cstrings;
+            sortCStrings(cwork.data(), count);
+            doNotOptimize(cwork);
+        });
+        runner.run("sort", "std::sort strcmp", input.label, count, [&]{
+            cwork = cstrings;
+            std::sort(cwork.begin(), cwork.end(), [](const char *a, const char *b){ return std::strcmp(a, b) < 0; });
+            doNotOptimize(cwork);
+        });
+        runner.run("sort", "sortStrings", input.label, count, [&]{
+            std::vector<String> work(strings);
+            sortStrings(work);
+            doNotOptimize(work);
+        });
+        runner.run("sort", "std::sort String", input.label, count, [&]{
+            std::vector<String> work(strings);
+            std::sort(work.begin(), work.end(), [](const String &a, const String &b){ return a.view() < b.view(); });
+            doNotOptimize(work);
+        });
+        runner.run("sort", "String copy only", input.label, count, [&]{
+            std::vector<String> work(strings);
+            doNotOptimize(work);
+        });
+    }
+}
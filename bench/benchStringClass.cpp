@@ -0,0 +1,57 @@
+/*
+Benchmark: SSO String vs. the previous heap-only layout and std::string.
+
+HeapOnlyString below is a copy of the layout String had before SSO: every object, even the empty one,
+owns a new char[] block and the moved-from object gets a fresh 1-byte buffer.
+Each case constructs, copies and moves strings of a given length.
+*/
+#include "benchHarness.hpp"
+#include "../String/StringClass.hpp"
+#include <string>
+#include <utility>
+
+class HeapOnlyString {
+    public:
+        HeapOnlyString() : data(new char[1]), length(0) { data[0] = '\0'; }
+        HeapOnlyString(const char *str) : data(nullptr), length(std::strlen(str)) {
+            data = new char[length + 1];
+            std::memcpy(data, str, length + 1);
+        }
+        HeapOnlyString(const HeapOnlyString &other) : data(new char[other.length + 1]), length(other.length) {
+            std::memcpy(data, other.data, length + 1);
+        }
+        HeapOnlyString(HeapOnlyString &&other) noexcept : data(other.data), length(other.length) {
+            other.data = new char[1];
+            other.data[0] = '\0';
+            other.length = 0;
+        }
+        ~HeapOnlyString() { delete[] data; }
+        const char* c_str() const { return data; }
+        size_t getLength() const { return length; }
+    private:
+        char *data;
+        size_t length;
+};
+
+template <typename StringType>
+static void constructCopyMove(const char *text){
+    StringType original(text);            // construct from C-string
+    StringType copy(original);            // copy
+    StringType moved(std::move(copy));    // move
+    doNotOptimize(moved.c_str()[0]);
+    doNotOptimize(original.c_str()[0]);
+}
+
+void benchStringClass(BenchRunner& runner){
+    if(!runner.wants("String")){
+        return;
+    }
+    const size_t lengths[] = {0, 8, 15, 23, 24, 64, 1024};
+    for(size_t len : lengths){
+        std::string text(len, 'x');
+        const char *cText = text.c_str();
+        runner.run("String", "String (SSO)", "ctor+copy+move", len, [&]{ constructCopyMove<String>(cText); });
+        runner.run("String", "heap-only String", "ctor+copy+move", len, [&]{ constructCopyMove<HeapOnlyString>(cText); });
+        runner.run("String", "std::string", "ctor+copy+move", len, [&]{ constructCopyMove<std::string>(cText); });
+    }
+}
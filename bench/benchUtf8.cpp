@@ -0,0 +1,67 @@
+#include "benchHarness.hpp"
+#include "../String/StringClass.hpp"
+#include "../myUtf8.hpp"
+#include <random>
+#include <string>
+
+/*
+UTF-8 on 1 MiB (capped by maxSize) of ASCII text and of mixed text (~1/3 ASCII, 2-, 3- and 4-byte sequences):
+    - validation: myUtf8Validate vs a byte-at-a-time decoder (the usual hand-written validator),
+    - code point counting and UTF-8 -> UTF-16 transcoding,
+    - String::codePointCount on a cached String: a load, whatever the length.
+*/
+
+// Table 3-7 of the Unicode standard, one sequence at a time
+static bool validateByteAtATime(const unsigned char* p, size_t n){
+    size_t i = 0;
+    while(i < n){
+        unsigned char lead = p[i];
+        if(lead < 0x80){
+            i++;
+            continue;
+        }
+        size_t length;
+        unsigned char low = 0x80, high = 0xBF;
+        if(lead >= 0xC2 && lead <= 0xDF) length = 2;
+        else if(lead >= 0xE0 && lead <= 0xEF){ length = 3; if(lead == 0xE0) low = 0xA0; if(lead == 0xED) high = 0x9F; }
+        else if(lead >= 0xF0 && lead <= 0xF4){ length = 4; if(lead == 0xF0) low = 0x90; if(lead == 0xF4) high = 0x8F; }
+        else return false;
+        if(i + length > n || p[i + 1] < low || p[i + 1] > high) return false;
+        for(size_t k = 2; k < length; k++){
+            if((p[i + k] & 0xC0) != 0x80) return false;
+        }
+        i += length;
+    }
+    return true;
+}
+
+void benchUtf8(BenchRunner& runner){
+    if(!runner.wants("utf8")){
+        return;
+    }
+    size_t size = runner.getOptions().maxSize < (size_t(1) << 20) ? runner.getOptions().maxSize : size_t(1) << 20;
+    std::mt19937 rng(9);
+    std::string ascii(size, 'a');
+    for(char &c : ascii) c = static_cast<char>(' ' + rng() % 95);
+    std::string mixed;
+    const char *samples[] = {"abc", "\xC3\xA9", "\xE6\x97\xA5", "\xF0\x9F\x8E\x89"};
+    while(mixed.size() + 4 <= size){
+        mixed += samples[rng() % 4];
+    }
+    struct Case { const char *variant; const std::string *text; };
+    Case cases[] = {{"ascii", &ascii}, {"mixed", &mixed}};
+    for(const Case &c : cases){
+        const std::string &text = *c.text;
+        runner.run("utf8", "myUtf8Validate", c.variant, text.size(), [&]{ bool valid = myUtf8Validate(text.data(), text.size()); doNotOptimize(valid); });
+        runner.run("utf8", "byte-at-a-time validate", c.variant, text.size(), [&]{
+            bool valid = validateByteAtATime(reinterpret_cast<const unsigned char*>(text.data()), text.size());
+            doNotOptimize(valid);
+        });
+        runner.run("utf8", "myUtf8CountCodePoints", c.variant, text.size(), [&]{ size_t count = myUtf8CountCodePoints(text.data(), text.size()); doNotOptimize(count); });
+        std::u16string utf16(text.size(), u'\0');
+        runner.run("utf8", "myUtf8ToUtf16", c.variant, text.size(), [&]{ size_t units = myUtf8ToUtf16(text.data(), text.size(), utf16.data()); doNotOptimize(units); });
+        String cached(text.c_str());
+        cached.codePointCount();
+        runner.run("utf8", "String::codePointCount", std::string(c.variant) + ", cached", text.size(), [&]{ size_t count = cached.codePointCount(); doNotOptimize(count); });
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+/*
+CPU feature detection shared by the SIMD kernels (myStrLen.cpp, myMemCpy.cpp, ...).
+
+Why runtime detection instead of compiling with -mavx2?
+A binary compiled with -mavx2 crashes with SIGILL on a CPU without AVX2. Instead, the library is compiled for the
+baseline ISA (SSE2 on x86-64) and each AVX2 kernel is compiled with __attribute__((target("avx2"))).
+At startup a dispatcher asks CPUID what the machine supports and picks the best kernel once.
+
+CPUID only tells us what the CPU supports. For AVX/AVX2 the OS must also save the YMM registers on a context switch,
+which is reported through XGETBV (XCR0 bits 1 and 2). Both checks are needed before using AVX2.
+*/
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#else
+#define SIMD_X86 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+// Compiles one function for a higher ISA than the rest of the translation unit
+#define TARGET_AVX2 __attribute__((target("avx2")))
+/*
+Word-at-a-time and vector kernels read whole aligned blocks, which may include bytes after the null-terminator.
+An aligned block never crosses a page boundary, so this can never fault, but AddressSanitizer still reports it.
+*/
+#define ALLOW_OVERREAD __attribute__((no_sanitize_address))
+#else
+#define TARGET_AVX2
+#define ALLOW_OVERREAD
+#endif
+
+struct CpuFeatures {
+    bool sse2 = false;
+    bool sse42 = false;
+    bool avx2 = false;
+    bool erms = false; // Enhanced REP MOVSB/STOSB: fast "rep movsb" for large copies
+};
+
+inline CpuFeatures detectCpuFeatures(){
+    CpuFeatures features;
+#if SIMD_X86
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if(!__get_cpuid(0, &eax, &ebx, &ecx, &edx)){
+        return features;
+    }
+    unsigned int maxLeaf = eax;
+
+    __cpuid(1, eax, ebx, ecx, edx);
+    features.sse2 = (edx & bit_SSE2) != 0;
+    features.sse42 = (ecx & bit_SSE4_2) != 0;
+    bool osSavesYmm = false;
+    if((ecx & bit_OSXSAVE) && (ecx & bit_AVX)){
+        unsigned int xcrLow = 0, xcrHigh = 0;
+        __asm__("xgetbv" : "=a"(xcrLow), "=d"(xcrHigh) : "c"(0));
+        osSavesYmm = (xcrLow & 0x6) == 0x6; // XMM (bit 1) and YMM (bit 2) state enabled
+    }
+
+    if(maxLeaf >= 7){
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        features.avx2 = osSavesYmm && (ebx & bit_AVX2) != 0;
+        features.erms = (ebx & (1u << 9)) != 0;
+    }
+#endif
+    return features;
+}
+
+// Detected once, on first use; every dispatcher shares the same result
+inline const CpuFeatures& cpuFeatures(){
+    static const CpuFeatures features = detectCpuFeatures();
+    return features;
+}
@@ -0,0 +1,181 @@
+#include "instrumentation.hpp"
+#include <atomic>
+#include <iostream>
+#include <mutex>
+
+static const char* const counterNames[counterCount] = {
+    "String default constructions",
+    "String C-string constructions",
+    "String copy constructions",
+    "String move constructions",
+    "String view constructions",
+    "String built constructions",
+    "String copy assignments",
+    "String move assignments",
+    "String heap allocations",
+    "String heap bytes",
+    "myString constructions",
+    "myString copy constructions",
+    "myString copy assignments",
+    "myString heap allocations",
+    "myString heap bytes",
+    "myMemCpy calls",
+    "myMemCpy bytes",
+    "myMemMove calls",
+    "myMemMove bytes",
+};
+
+const char* counterName(Counter counter){
+    return counterNames[static_cast<size_t>(counter)];
+}
+
+bool instrumentationEnabled(){
+#ifdef STRING_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef STRING_INSTRUMENTATION
+
+/*
+One block per thread, linked into a global list so snapshots can find it.
+Only the owning thread writes a block; the counters are atomics only so that a concurrent snapshot reads whole
+values. A relaxed load + store compiles to a plain add on x86, with no lock prefix.
+When a thread exits, its totals are folded into retiredTotals and the block is unlinked.
+Everything here is constant-initialized, so it is usable from any static constructor or destructor.
+*/
+struct ThreadCounters {
+    std::atomic<uint64_t> counters[counterCount] = {};
+    std::atomic<uint64_t> copySizeHistogram[copySizeBuckets] = {};
+    ThreadCounters *next = nullptr;
+
+    ThreadCounters();
+    ~ThreadCounters();
+};
+
+static std::mutex registryMutex;
+static ThreadCounters *liveThreads = nullptr;
+static uint64_t retiredCounters[counterCount];
+static uint64_t retiredHistogram[copySizeBuckets];
+
+ThreadCounters::ThreadCounters(){
+    std::lock_guard<std::mutex> lock(registryMutex);
+    next = liveThreads;
+    liveThreads = this;
+}
+
+ThreadCounters::~ThreadCounters(){
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for(size_t i = 0; i < counterCount; i++){
+        retiredCounters[i] += counters[i].load(std::memory_order_relaxed);
+    }
+    for(size_t i = 0; i < copySizeBuckets; i++){
+        retiredHistogram[i] += copySizeHistogram[i].load(std::memory_order_relaxed);
+    }
+    for(ThreadCounters **link = &liveThreads; *link; link = &(*link)->next){
+        if(*link == this){
+            *link = next;
+            break;
+        }
+    }
+}
+
+static ThreadCounters& threadCounters(){
+    thread_local ThreadCounters counters;
+    return counters;
+}
+
+static void bump(std::atomic<uint64_t> &value, uint64_t amount){
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+void recordCounter(Counter counter, uint64_t amount){
+    bump(threadCounters().counters[static_cast<size_t>(counter)], amount);
+}
+
+void recordCopySize(size_t bytes){
+    size_t bucket = 0;
+    while(bytes >> bucket){
+        bucket++; // Number of significant bits: 0 for 0, 1 for 1, 2 for 2..3, ...
+    }
+    bump(threadCounters().copySizeHistogram[bucket], 1);
+}
+
+InstrumentationSnapshot instrumentationSnapshot(){
+    InstrumentationSnapshot snapshot;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for(size_t i = 0; i < counterCount; i++){
+        snapshot.counters[i] = retiredCounters[i];
+    }
+    for(size_t i = 0; i < copySizeBuckets; i++){
+        snapshot.copySizeHistogram[i] = retiredHistogram[i];
+    }
+    for(ThreadCounters *thread = liveThreads; thread; thread = thread->next){
+        for(size_t i = 0; i < counterCount; i++){
+            snapshot.counters[i] += thread->counters[i].load(std::memory_order_relaxed);
+        }
+        for(size_t i = 0; i < copySizeBuckets; i++){
+            snapshot.copySizeHistogram[i] += thread->copySizeHistogram[i].load(std::memory_order_relaxed);
+        }
+    }
+    return snapshot;
+}
+
+void resetInstrumentation(){
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for(size_t i = 0; i < counterCount; i++){
+        retiredCounters[i] = 0;
+    }
+    for(size_t i = 0; i < copySizeBuckets; i++){
+        retiredHistogram[i] = 0;
+    }
+    for(ThreadCounters *thread = liveThreads; thread; thread = thread->next){
+        for(std::atomic<uint64_t> &value : thread->counters){
+            value.store(0, std::memory_order_relaxed);
+        }
+        for(std::atomic<uint64_t> &value : thread->copySizeHistogram){
+            value.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+// Prints the totals when the program exits (after the main thread's block has been retired)
+static struct InstrumentationExitDump {
+    ~InstrumentationExitDump(){
+        std::cerr << "\n--- String instrumentation (at exit) ---\n";
+        dumpInstrumentation(std::cerr);
+    }
+} exitDump;
+
+#else
+
+InstrumentationSnapshot instrumentationSnapshot(){
+    return InstrumentationSnapshot{};
+}
+
+void resetInstrumentation(){}
+
+#endif
+
+void dumpInstrumentation(std::ostream &out){
+    if(!instrumentationEnabled()){
+        out << "instrumentation disabled (build with -DSTRING_INSTRUMENTATION=ON)\n";
+        return;
+    }
+    InstrumentationSnapshot snapshot = instrumentationSnapshot();
+    for(size_t i = 0; i < counterCount; i++){
+        if(snapshot.counters[i] != 0){
+            out << "  " << counterNames[i] << ": " << snapshot.counters[i] << "\n";
+        }
+    }
+    out << "  copy sizes:";
+    for(size_t bucket = 0; bucket < copySizeBuckets; bucket++){
+        if(snapshot.copySizeHistogram[bucket] != 0){
+            uint64_t low = bucket == 0 ? 0 : uint64_t(1) << (bucket - 1);
+            out << " [" << low << "+]: " << snapshot.copySizeHistogram[bucket];
+        }
+    }
+    out << "\n";
+}
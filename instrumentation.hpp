@@ -0,0 +1,76 @@
+#pragma once
+/*
+Build-time instrumentation of String, myString, myMemCpy and myMemMove.
+
+lvalue_rvalue.cpp shows copy vs move on toy examples, but in real code an accidental copy (a missing std::move, a
+by-value parameter, a temporary bound to const&) is silent. With instrumentation enabled every construction,
+copy, move, heap allocation and memcpy/memmove call is counted, with a power-of-two histogram of the copied sizes,
+so the hot accidental copies show up in numbers.
+
+Enable with -DSTRING_INSTRUMENTATION=ON in CMake (it defines STRING_INSTRUMENTATION for the library and everything
+linking it). When it is off, the INSTRUMENT_* macros expand to nothing: no code, no data, no TLS access.
+
+Counters are per thread: each thread increments its own block with plain relaxed stores (no atomic RMW, no shared
+cache line), and a snapshot adds up all live blocks plus the totals of threads that already exited.
+A summary is printed to stderr at exit.
+*/
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+enum class Counter {
+    StringDefaultConstructions,
+    StringCStringConstructions,
+    StringCopyConstructions,
+    StringMoveConstructions,
+    StringViewConstructions,
+    StringBuiltConstructions,   // from a concatenation, a StringBuilder or a search/replace result
+    StringCopyAssignments,
+    StringMoveAssignments,
+    StringHeapAllocations,
+    StringHeapBytes,
+    MyStringConstructions,
+    MyStringCopyConstructions,
+    MyStringCopyAssignments,
+    MyStringHeapAllocations,
+    MyStringHeapBytes,
+    MemCpyCalls,
+    MemCpyBytes,
+    MemMoveCalls,
+    MemMoveBytes,
+    Count
+};
+
+constexpr size_t counterCount = static_cast<size_t>(Counter::Count);
+// Bucket k counts copies of [2^(k-1), 2^k) bytes; bucket 0 counts empty copies
+constexpr size_t copySizeBuckets = 65;
+
+struct InstrumentationSnapshot {
+    uint64_t counters[counterCount] = {};
+    uint64_t copySizeHistogram[copySizeBuckets] = {}; // String/myString copies (constructions and assignments)
+
+    uint64_t operator[](Counter counter) const { return counters[static_cast<size_t>(counter)]; }
+};
+
+// true when the library was built with STRING_INSTRUMENTATION
+bool instrumentationEnabled();
+// Sum of the counters of every thread (all zero when instrumentation is disabled)
+InstrumentationSnapshot instrumentationSnapshot();
+// Zeroes every counter. Increments racing with the reset may survive it.
+void resetInstrumentation();
+// Prints the non-zero counters and the histogram
+void dumpInstrumentation(std::ostream &out);
+const char* counterName(Counter counter);
+
+#ifdef STRING_INSTRUMENTATION
+void recordCounter(Counter counter, uint64_t amount);
+void recordCopySize(size_t bytes);
+#define INSTRUMENT_COUNT(counter) recordCounter(Counter::counter, 1)
+#define INSTRUMENT_ADD(counter, amount) recordCounter(Counter::counter, (amount))
+// A String/myString copy of bytes characters: counted and added to the size histogram
+#define INSTRUMENT_COPY(counter, bytes) (recordCounter(Counter::counter, 1), recordCopySize(bytes))
+#else
+#define INSTRUMENT_COUNT(counter) ((void)0)
+#define INSTRUMENT_ADD(counter, amount) ((void)0)
+#define INSTRUMENT_COPY(counter, bytes) ((void)0)
+#endif
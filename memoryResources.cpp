@@ -0,0 +1,218 @@
+#include "memoryResources.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static size_t alignUp(size_t value, size_t alignment){
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/* ArenaResource */
+
+ArenaResource::ArenaResource(size_t chunkSize, std::pmr::memory_resource *upstream)
+    : upstream(upstream), chunkSize(chunkSize < 1024 ? 1024 : chunkSize) {}
+
+ArenaResource::~ArenaResource(){
+    release();
+}
+
+void ArenaResource::advanceChunk(size_t bytes){
+    // Reuse the next chunk kept from before the last reset() if it is big enough
+    if(current && current->next && current->next->payloadSize >= bytes){
+        current = current->next;
+    }
+    else{
+        size_t payloadSize = bytes > chunkSize ? bytes : chunkSize;
+        Chunk *chunk = static_cast<Chunk*>(upstream->allocate(sizeof(Chunk) + payloadSize, alignof(Chunk)));
+        chunk->payloadSize = payloadSize;
+        reserved += sizeof(Chunk) + payloadSize;
+        // Insert after current so chunks already kept for reuse stay in the list
+        if(current){
+            chunk->next = current->next;
+            current->next = chunk;
+        }
+        else{
+            chunk->next = first;
+            first = chunk;
+        }
+        current = chunk;
+    }
+    cursor = current->payload();
+    limit = cursor + current->payloadSize;
+}
+
+void* ArenaResource::do_allocate(size_t bytes, size_t alignment){
+    uintptr_t address = alignUp(reinterpret_cast<uintptr_t>(cursor), alignment);
+    if(!cursor || address + bytes > reinterpret_cast<uintptr_t>(limit)){
+        advanceChunk(bytes + alignment); // Worst case padding to reach the alignment
+        address = alignUp(reinterpret_cast<uintptr_t>(cursor), alignment);
+    }
+    char *result = reinterpret_cast<char*>(address);
+    used += (result + bytes) - cursor;
+    cursor = result + bytes;
+    return result;
+}
+
+void ArenaResource::reset() noexcept {
+    current = first;
+    cursor = first ? first->payload() : nullptr;
+    limit = first ? cursor + first->payloadSize : nullptr;
+    used = 0;
+}
+
+void ArenaResource::release() noexcept {
+    Chunk *chunk = first;
+    while(chunk){
+        Chunk *next = chunk->next;
+        upstream->deallocate(chunk, sizeof(Chunk) + chunk->payloadSize, alignof(Chunk));
+        chunk = next;
+    }
+    first = current = nullptr;
+    cursor = limit = nullptr;
+    used = reserved = 0;
+}
+
+/* SizeClassPoolResource */
+
+SizeClassPoolResource::SizeClassPoolResource(std::pmr::memory_resource *upstream, size_t slabSize)
+    : upstream(upstream), slabSize(slabSize < 4 * maxPooledSize ? 4 * maxPooledSize : slabSize) {}
+
+SizeClassPoolResource::~SizeClassPoolResource(){
+    release();
+}
+
+// 1..16 -> 0, 17..32 -> 1, ..., 513..1024 -> 6
+size_t SizeClassPoolResource::classIndex(size_t bytes){
+    size_t index = 0;
+    size_t classSize = minClassSize;
+    while(classSize < bytes){
+        classSize <<= 1;
+        index++;
+    }
+    return index;
+}
+
+void* SizeClassPoolResource::do_allocate(size_t bytes, size_t alignment){
+    if(!isPooled(bytes, alignment)){
+        return upstream->allocate(bytes, alignment);
+    }
+    size_t index = classIndex(bytes);
+    if(FreeBlock *block = freeLists[index]){
+        freeLists[index] = block->next; // O(1) pop
+        return block;
+    }
+    // Free list empty: carve a new block from the current slab. Class sizes are multiples of 16, so blocks stay aligned.
+    size_t classSize = minClassSize << index;
+    if(!cursor || cursor + classSize > limit){
+        Slab *slab = static_cast<Slab*>(upstream->allocate(sizeof(Slab) + slabSize, alignof(Slab)));
+        slab->payloadSize = slabSize;
+        slab->next = slabs;
+        slabs = slab;
+        cursor = slab->payload();
+        limit = cursor + slabSize;
+    }
+    void *result = cursor;
+    cursor += classSize;
+    return result;
+}
+
+void SizeClassPoolResource::do_deallocate(void *p, size_t bytes, size_t alignment){
+    if(!isPooled(bytes, alignment)){
+        upstream->deallocate(p, bytes, alignment);
+        return;
+    }
+    size_t index = classIndex(bytes);
+    FreeBlock *block = static_cast<FreeBlock*>(p);
+    block->next = freeLists[index]; // O(1) push
+    freeLists[index] = block;
+}
+
+void SizeClassPoolResource::release() noexcept {
+    Slab *slab = slabs;
+    while(slab){
+        Slab *next = slab->next;
+        upstream->deallocate(slab, sizeof(Slab) + slab->payloadSize, alignof(Slab));
+        slab = next;
+    }
+    slabs = nullptr;
+    cursor = limit = nullptr;
+    for(FreeBlock *&list : freeLists){
+        list = nullptr;
+    }
+}
+
+/* ReallocResource */
+
+/*
+Blocks are routed by size, and memory_resource passes the size to every call, so a block is always freed and
+resized by the allocator that made it: below mapThreshold malloc/realloc/free, above it mmap/mremap/munmap.
+A resize that crosses the threshold allocates in the other allocator and copies. Over-aligned requests (only
+possible below a page) fall back to aligned_alloc and are never resized in place.
+*/
+static size_t pageSize(){
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+static size_t mappedSize(size_t bytes){
+    return alignUp(bytes, pageSize());
+}
+
+void* ReallocResource::do_allocate(size_t bytes, size_t alignment){
+    if(isMapped(bytes) && alignment <= pageSize()){
+        void *p = mmap(nullptr, mappedSize(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(p == MAP_FAILED){
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+    void *p = alignment <= alignof(std::max_align_t) ? std::malloc(bytes ? bytes : 1)
+                                                      : std::aligned_alloc(alignment, alignUp(bytes ? bytes : 1, alignment));
+    if(!p){
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void ReallocResource::do_deallocate(void *p, size_t bytes, size_t alignment){
+    if(isMapped(bytes) && alignment <= pageSize()){
+        munmap(p, mappedSize(bytes));
+    }
+    else{
+        std::free(p);
+    }
+}
+
+void* ReallocResource::reallocate(void *p, size_t oldBytes, size_t newBytes, size_t alignment){
+#ifdef __linux__
+    if(isMapped(oldBytes) && isMapped(newBytes) && alignment <= pageSize()){
+        if(mappedSize(oldBytes) == mappedSize(newBytes)){
+            return p;
+        }
+        void *moved = mremap(p, mappedSize(oldBytes), mappedSize(newBytes), MREMAP_MAYMOVE);
+        if(moved == MAP_FAILED){
+            throw std::bad_alloc();
+        }
+        return moved;
+    }
+#endif
+    if(!isMapped(oldBytes) && !isMapped(newBytes) && alignment <= alignof(std::max_align_t)){
+        void *moved = std::realloc(p, newBytes ? newBytes : 1);
+        if(!moved){
+            throw std::bad_alloc();
+        }
+        return moved;
+    }
+    void *fresh = do_allocate(newBytes, alignment);
+    std::memcpy(fresh, p, oldBytes < newBytes ? oldBytes : newBytes);
+    do_deallocate(p, oldBytes, alignment);
+    return fresh;
+}
+
+ReallocResource* reallocResource(){
+    static ReallocResource instance;
+    return &instance;
+}
@@ -0,0 +1,137 @@
+#pragma once
+/*
+Memory resources for request-scoped workloads.
+
+Both classes derive from std::pmr::memory_resource, so anything that accepts a memory_resource* (String, std::pmr
+containers) can allocate from them. Neither is thread-safe: use one instance per request / per thread, like
+std::pmr::unsynchronized_pool_resource.
+
+ArenaResource (bump-pointer arena):
+    allocate   = move a cursor forward inside the current chunk (a few instructions, no free-list search)
+    deallocate = no-op
+    reset()    = rewind the cursor to the first chunk: every allocation made since the last reset is gone in O(1).
+                 Chunks are kept, so the next request allocates from memory that is already mapped and warm.
+    Typical use: all strings of one request are created in the arena, the arena is reset when the request ends.
+
+SizeClassPoolResource (segregated free lists):
+    Requests up to maxPooledSize are rounded up to a power-of-two size class (16, 32, ..., 1024 bytes).
+    Each class has its own free list, so allocate/deallocate are O(1) pops/pushes and freed blocks are reused.
+    Larger requests go straight to the upstream resource.
+    Typical use: long-running workloads where strings die individually and an arena would never be reset.
+
+ReallocResource (resizable blocks):
+    std::pmr::memory_resource cannot resize a block, so a growing buffer is always allocate + copy + free.
+    ReallocResource adds reallocate(): blocks below mapThreshold come from malloc and are resized with realloc,
+    larger blocks are mapped directly with mmap and resized with mremap, which moves page-table entries instead of
+    bytes, so growing a 1 GiB string costs microseconds instead of a 1 GiB copy. String uses reallocate() when its
+    resource is a ReallocResource. Stateless and thread-safe; reallocResource() returns a process-wide instance.
+    Typical use: a few very large strings that grow by appending (log buffers, response bodies).
+*/
+#include <cstddef>
+#include <memory_resource>
+
+class ArenaResource : public std::pmr::memory_resource {
+    public:
+        explicit ArenaResource(size_t chunkSize = 64 * 1024,
+                               std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+        ~ArenaResource() override;
+
+        ArenaResource(const ArenaResource&) = delete;
+        ArenaResource& operator=(const ArenaResource&) = delete;
+
+        // Frees every allocation in O(1). Chunks are kept for reuse.
+        void reset() noexcept;
+        // Returns all chunks to the upstream resource.
+        void release() noexcept;
+
+        // Bytes handed out since the last reset (including alignment padding)
+        size_t bytesUsed() const { return used; }
+        // Bytes obtained from the upstream resource
+        size_t bytesReserved() const { return reserved; }
+
+    private:
+        // Each chunk starts with this header; its payload follows, aligned to max_align_t
+        struct alignas(alignof(std::max_align_t)) Chunk {
+            Chunk *next;
+            size_t payloadSize;
+            char* payload() { return reinterpret_cast<char*>(this + 1); }
+        };
+
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void*, size_t, size_t) override {} // Memory is reclaimed by reset()/release()
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+        // Makes current point at a chunk with at least bytes of payload, reusing the next chunk when it is large enough
+        void advanceChunk(size_t bytes);
+
+        std::pmr::memory_resource *upstream;
+        size_t chunkSize;
+        Chunk *first = nullptr;   // chunks in allocation order
+        Chunk *current = nullptr; // chunk the cursor is in
+        char *cursor = nullptr;
+        char *limit = nullptr;
+        size_t used = 0;
+        size_t reserved = 0;
+};
+
+class SizeClassPoolResource : public std::pmr::memory_resource {
+    public:
+        static constexpr size_t minClassSize = 16;
+        static constexpr size_t maxPooledSize = 1024;
+        static constexpr size_t classCount = 7; // 16, 32, 64, 128, 256, 512, 1024
+
+        explicit SizeClassPoolResource(std::pmr::memory_resource *upstream = std::pmr::get_default_resource(),
+                                       size_t slabSize = 64 * 1024);
+        ~SizeClassPoolResource() override;
+
+        SizeClassPoolResource(const SizeClassPoolResource&) = delete;
+        SizeClassPoolResource& operator=(const SizeClassPoolResource&) = delete;
+
+        // Returns every slab to the upstream resource. Outstanding pooled blocks become invalid.
+        void release() noexcept;
+
+    private:
+        struct FreeBlock { FreeBlock *next; };
+        struct alignas(alignof(std::max_align_t)) Slab {
+            Slab *next;
+            size_t payloadSize;
+            char* payload() { return reinterpret_cast<char*>(this + 1); }
+        };
+
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+        static size_t classIndex(size_t bytes);
+        static bool isPooled(size_t bytes, size_t alignment) {
+            return bytes <= maxPooledSize && alignment <= alignof(std::max_align_t);
+        }
+
+        std::pmr::memory_resource *upstream;
+        size_t slabSize;
+        FreeBlock *freeLists[classCount] = {};
+        Slab *slabs = nullptr;
+        char *cursor = nullptr; // unused space at the end of the newest slab
+        char *limit = nullptr;
+};
+
+class ReallocResource : public std::pmr::memory_resource {
+    public:
+        static constexpr size_t mapThreshold = size_t(1) << 20; // 1 MiB
+
+        // Resizes a block allocated from this resource to newBytes, keeping min(oldBytes, newBytes) bytes of its
+        // contents. The block may move; on failure std::bad_alloc is thrown and the old block is left untouched.
+        void* reallocate(void *p, size_t oldBytes, size_t newBytes, size_t alignment = alignof(std::max_align_t));
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+        // Stateless: any ReallocResource can free the blocks of another
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return dynamic_cast<const ReallocResource*>(&other) != nullptr;
+        }
+
+        static bool isMapped(size_t bytes) { return bytes >= mapThreshold; }
+};
+
+ReallocResource* reallocResource();
@@ -0,0 +1,228 @@
+#include "myCase.hpp"
+#include "myHash.hpp"
+#include "cpuFeatures.hpp"
+#include <atomic>
+
+/*
+Scalar kernels: (c - first) < 26 as an unsigned comparison is the whole range check, and xoring 0x20 flips the case
+of an ASCII letter in both directions. Used for inputs shorter than one vector and on non-x86 targets.
+*/
+static inline unsigned char flipIfInRange(unsigned char c, unsigned char first){
+    return static_cast<unsigned char>(c ^ ((static_cast<unsigned char>(c - first) < 26) << 5));
+}
+
+static inline unsigned char lowerByte(unsigned char c){
+    return flipIfInRange(c, 'A');
+}
+
+static void convertScalar(char* dst, const char* src, size_t n, char first){
+    for(size_t i = 0; i < n; i++){
+        dst[i] = static_cast<char>(flipIfInRange(static_cast<unsigned char>(src[i]), static_cast<unsigned char>(first)));
+    }
+}
+
+static size_t mismatchScalar(const char* a, const char* b, size_t n){
+    for(size_t i = 0; i < n; i++){
+        if(lowerByte(static_cast<unsigned char>(a[i])) != lowerByte(static_cast<unsigned char>(b[i]))){
+            return i;
+        }
+    }
+    return n;
+}
+
+#if SIMD_X86
+/*
+Range check with signed byte compares: first <= c <= first + 25  <=>  c > first - 1 && c < first + 26.
+Bytes >= 0x80 are negative as signed chars, so they never fall in the range and UTF-8 passes through unchanged.
+*/
+static inline __m128i flipSse2(__m128i block, __m128i below, __m128i above, __m128i flip){
+    __m128i inRange = _mm_and_si128(_mm_cmpgt_epi8(block, below), _mm_cmplt_epi8(block, above));
+    return _mm_xor_si128(block, _mm_and_si128(inRange, flip));
+}
+
+/*
+The last, partial block is handled by converting the final 16 bytes again, overlapping the previous block.
+This is safe in place because conversion is idempotent: an already lowered byte is no longer in 'A'..'Z'.
+*/
+static void convertSse2(char* dst, const char* src, size_t n, char first){
+    if(n < 16){
+        convertScalar(dst, src, n, first);
+        return;
+    }
+    const __m128i below = _mm_set1_epi8(static_cast<char>(first - 1));
+    const __m128i above = _mm_set1_epi8(static_cast<char>(first + 26));
+    const __m128i flip = _mm_set1_epi8(0x20);
+    size_t i = 0;
+    for(; i + 16 <= n; i += 16){
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), flipSse2(block, below, above, flip));
+    }
+    if(i < n){
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + n - 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + n - 16), flipSse2(block, below, above, flip));
+    }
+}
+
+static size_t mismatchSse2(const char* a, const char* b, size_t n){
+    const __m128i below = _mm_set1_epi8('A' - 1);
+    const __m128i above = _mm_set1_epi8('Z' + 1);
+    const __m128i flip = _mm_set1_epi8(0x20);
+    size_t i = 0;
+    for(; i + 16 <= n; i += 16){
+        __m128i x = flipSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), below, above, flip);
+        __m128i y = flipSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)), below, above, flip);
+        unsigned differ = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) ^ 0xFFFFu;
+        if(differ){
+            return i + __builtin_ctz(differ);
+        }
+    }
+    return i + mismatchScalar(a + i, b + i, n - i);
+}
+
+TARGET_AVX2 static inline __m256i flipAvx2(__m256i block, __m256i below, __m256i above, __m256i flip){
+    __m256i inRange = _mm256_and_si256(_mm256_cmpgt_epi8(block, below), _mm256_cmpgt_epi8(above, block));
+    return _mm256_xor_si256(block, _mm256_and_si256(inRange, flip));
+}
+
+/*
+The AVX2 kernels handle their short inputs and tails themselves instead of calling the SSE2 kernels: those are
+compiled without VEX encoding, and legacy SSE instructions executed while the upper halves of the YMM registers are
+dirty pay a state-transition penalty on many Intel cores (hundreds of cycles per call). flipSse2 is inlined here and
+therefore VEX-encoded.
+*/
+TARGET_AVX2 static void convertAvx2(char* dst, const char* src, size_t n, char first){
+    if(n < 32){
+        if(n < 16){
+            convertScalar(dst, src, n, first);
+            return;
+        }
+        // 16..31 bytes: two overlapping 16-byte blocks, loaded before either is stored (dst may equal src)
+        const __m128i below = _mm_set1_epi8(static_cast<char>(first - 1));
+        const __m128i above = _mm_set1_epi8(static_cast<char>(first + 26));
+        const __m128i flip = _mm_set1_epi8(0x20);
+        __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + n - 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), flipSse2(head, below, above, flip));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + n - 16), flipSse2(tail, below, above, flip));
+        return;
+    }
+    const __m256i below = _mm256_set1_epi8(static_cast<char>(first - 1));
+    const __m256i above = _mm256_set1_epi8(static_cast<char>(first + 26));
+    const __m256i flip = _mm256_set1_epi8(0x20);
+    size_t i = 0;
+    for(; i + 64 <= n; i += 64){
+        __m256i block0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i block1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), flipAvx2(block0, below, above, flip));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 32), flipAvx2(block1, below, above, flip));
+    }
+    for(; i + 32 <= n; i += 32){
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), flipAvx2(block, below, above, flip));
+    }
+    if(i < n){
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + n - 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + n - 32), flipAvx2(block, below, above, flip));
+    }
+}
+
+TARGET_AVX2 static size_t mismatchAvx2(const char* a, const char* b, size_t n){
+    const __m256i below = _mm256_set1_epi8('A' - 1);
+    const __m256i above = _mm256_set1_epi8('Z' + 1);
+    const __m256i flip = _mm256_set1_epi8(0x20);
+    size_t i = 0;
+    for(; i + 32 <= n; i += 32){
+        __m256i x = flipAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)), below, above, flip);
+        __m256i y = flipAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)), below, above, flip);
+        unsigned differ = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+        if(differ){
+            return i + __builtin_ctz(differ);
+        }
+    }
+    if(i + 16 <= n){
+        const __m128i below16 = _mm_set1_epi8('A' - 1);
+        const __m128i above16 = _mm_set1_epi8('Z' + 1);
+        const __m128i flip16 = _mm_set1_epi8(0x20);
+        __m128i x = flipSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), below16, above16, flip16);
+        __m128i y = flipSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)), below16, above16, flip16);
+        unsigned differ = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) ^ 0xFFFFu;
+        if(differ){
+            return i + __builtin_ctz(differ);
+        }
+        i += 16;
+    }
+    return i + mismatchScalar(a + i, b + i, n - i);
+}
+#endif
+
+struct CaseKernels {
+    void (*convert)(char*, const char*, size_t, char);
+    size_t (*mismatch)(const char*, const char*, size_t);
+    const char* name;
+};
+
+static const CaseKernels scalarKernels = {convertScalar, mismatchScalar, "scalar"};
+#if SIMD_X86
+static const CaseKernels sse2Kernels = {convertSse2, mismatchSse2, "sse2"};
+static const CaseKernels avx2Kernels = {convertAvx2, mismatchAvx2, "avx2"};
+#endif
+
+static const CaseKernels* selectCaseKernels(){
+#if SIMD_X86
+    const CpuFeatures& cpu = cpuFeatures();
+    if(cpu.avx2) return &avx2Kernels;
+    if(cpu.sse2) return &sse2Kernels;
+#endif
+    return &scalarKernels;
+}
+
+static std::atomic<const CaseKernels*> activeCaseKernels{nullptr};
+
+static const CaseKernels* caseKernels(){
+    const CaseKernels* kernels = activeCaseKernels.load(std::memory_order_relaxed);
+    if(!kernels){
+        kernels = selectCaseKernels();
+        activeCaseKernels.store(kernels, std::memory_order_relaxed);
+    }
+    return kernels;
+}
+
+void myToLower(char* dst, const char* src, size_t n){
+    caseKernels()->convert(dst, src, n, 'A');
+}
+
+void myToUpper(char* dst, const char* src, size_t n){
+    caseKernels()->convert(dst, src, n, 'a');
+}
+
+size_t myMismatchIgnoreCase(const char* a, const char* b, size_t n){
+    return caseKernels()->mismatch(a, b, n);
+}
+
+int myCompareIgnoreCase(const char* a, size_t aLength, const char* b, size_t bLength){
+    size_t common = aLength < bLength ? aLength : bLength;
+    size_t i = myMismatchIgnoreCase(a, b, common);
+    if(i < common){
+        return static_cast<int>(lowerByte(static_cast<unsigned char>(a[i]))) - static_cast<int>(lowerByte(static_cast<unsigned char>(b[i])));
+    }
+    return aLength < bLength ? -1 : (aLength > bLength ? 1 : 0);
+}
+
+uint64_t myHashIgnoreCase(const void* data, size_t n, uint64_t seed){
+    static constexpr size_t blockSize = 1024;
+    const char* p = static_cast<const char*>(data);
+    char lowered[blockSize];
+    uint64_t hash = seed;
+    size_t offset = 0;
+    do{
+        size_t chunk = n - offset < blockSize ? n - offset : blockSize;
+        myToLower(lowered, p + offset, chunk);
+        hash = myHash(lowered, chunk, hash);
+        offset += chunk;
+    }while(offset < n);
+    return hash;
+}
+
+const char* myCaseKernelName(){
+    return caseKernels()->name;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/*
+ASCII case primitives (used by String::toUpper/toLower and the *IgnoreCase functions).
+
+Only 'A'..'Z' and 'a'..'z' are mapped; every other byte, including UTF-8 sequences, is left untouched, so the
+functions are locale-independent and safe on any byte string. This is what case-insensitive protocol tokens
+(HTTP header names, MIME types, hostnames) need.
+
+Each 16/32-byte block is range-compared against 'A'..'Z' (or 'a'..'z') and 0x20 is xored into the matching bytes,
+so there is no per-byte branch. AVX2 or SSE2 is chosen at runtime, with a scalar fallback.
+*/
+
+// dst[i] = lower/upper(src[i]) for n bytes. dst may equal src (in-place), otherwise the ranges must not overlap.
+void myToLower(char* dst, const char* src, size_t n);
+void myToUpper(char* dst, const char* src, size_t n);
+
+// Index of the first i with lower(a[i]) != lower(b[i]), or n if the ranges are equal ignoring case
+size_t myMismatchIgnoreCase(const char* a, const char* b, size_t n);
+
+inline bool myEqualsIgnoreCase(const char* a, size_t aLength, const char* b, size_t bLength){
+    return aLength == bLength && myMismatchIgnoreCase(a, b, aLength) == aLength;
+}
+
+// <0, 0, >0 like memcmp on the lowered bytes (unsigned), the shorter string first when one is a prefix of the other
+int myCompareIgnoreCase(const char* a, size_t aLength, const char* b, size_t bLength);
+
+/*
+myHash of the lowered bytes, without allocating a lowered copy: the text is lowered 1 KiB at a time into a stack
+buffer and each block is hashed with the previous block's hash as seed. Up to 1 KiB this is exactly
+myHash(lower(text)); strings that differ only in case always hash alike.
+*/
+uint64_t myHashIgnoreCase(const void* data, size_t n, uint64_t seed = 0);
+
+// Name of the kernel selected at runtime ("avx2", "sse2" or "scalar")
+const char* myCaseKernelName();
@@ -0,0 +1,297 @@
+#include "myHash.hpp"
+#include "cpuFeatures.hpp"
+#include <array>
+#include <atomic>
+#include <cstring>
+
+static constexpr uint64_t wyp0 = 0xa0761d6478bd642fULL;
+static constexpr uint64_t wyp1 = 0xe7037ed1a0b428dbULL;
+static constexpr uint64_t prime64_1 = 0x9E3779B185EBCA87ULL;
+static constexpr uint64_t prime32_1 = 0x9E3779B1U;
+
+static inline uint64_t read64(const unsigned char* p){
+    uint64_t value;
+    std::memcpy(&value, p, 8);
+    return value;
+}
+
+static inline uint64_t read32(const unsigned char* p){
+    uint32_t value;
+    std::memcpy(&value, p, 4);
+    return value;
+}
+
+// 64x64 -> 128-bit multiply, both halves folded together: the core mixing step of wyhash and XXH3
+static inline uint64_t foldedMultiply(uint64_t a, uint64_t b){
+    __uint128_t product = static_cast<__uint128_t>(a) * b;
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+}
+
+static inline uint64_t avalanche(uint64_t h){
+    h ^= h >> 37;
+    h *= 0x165667919E3779F9ULL;
+    return h ^ (h >> 32);
+}
+
+/*
+Keys for the long path, generated at compile time with splitmix64:
+    mediumKeys are xored into the 16-byte pairs of the 17..128 byte path,
+    stripeKeys[s][lane] is xored into lane of the s-th stripe of a 1 KiB block (XXH3 slides its secret instead),
+    scrambleKeys[lane] is xored in when the block is scrambled,
+    mergeKeys[lane] is used when the accumulators are folded into the result.
+*/
+static constexpr size_t lanes = 8;
+static constexpr size_t stripeSize = 64;
+static constexpr size_t stripesPerBlock = 16;
+
+struct LongKeys {
+    uint64_t mediumKeys[16];
+    uint64_t stripeKeys[stripesPerBlock][lanes];
+    uint64_t scrambleKeys[lanes];
+    uint64_t mergeKeys[lanes];
+};
+
+static constexpr LongKeys makeLongKeys(){
+    LongKeys keys{};
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    auto next = [&state]{
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    };
+    for(uint64_t& key : keys.mediumKeys) key = next();
+    for(auto& stripe : keys.stripeKeys){
+        for(uint64_t& key : stripe) key = next();
+    }
+    for(uint64_t& key : keys.scrambleKeys) key = next();
+    for(uint64_t& key : keys.mergeKeys) key = next();
+    return keys;
+}
+
+static constexpr LongKeys longKeys = makeLongKeys();
+
+static uint64_t hashShort(const unsigned char* p, size_t length, uint64_t seed){
+    uint64_t a = 0, b = 0;
+    if(length >= 4){
+        size_t middle = (length >> 3) << 2; // 0 for 4..7 bytes, 4 for 8..16: the loads cover every byte
+        a = (read32(p) << 32) | read32(p + middle);
+        b = (read32(p + length - 4) << 32) | read32(p + length - 4 - middle);
+    }
+    else if(length > 0){
+        a = (uint64_t(p[0]) << 16) | (uint64_t(p[length >> 1]) << 8) | p[length - 1];
+    }
+    return foldedMultiply(foldedMultiply(a ^ wyp1, b ^ seed ^ wyp0) ^ length, wyp1 ^ seed);
+}
+
+static uint64_t hashMedium(const unsigned char* p, size_t length, uint64_t seed){
+    const uint64_t* keys = longKeys.mediumKeys;
+    uint64_t acc = length * prime64_1 + seed;
+    auto pair = [&](size_t front, size_t k){
+        const unsigned char* back = p + length - 16 - front;
+        acc += foldedMultiply(read64(p + front) ^ (keys[k] + seed), read64(p + front + 8) ^ (keys[k + 1] - seed));
+        acc += foldedMultiply(read64(back) ^ (keys[k + 2] + seed), read64(back + 8) ^ (keys[k + 3] - seed));
+    };
+    if(length > 32){
+        if(length > 64){
+            if(length > 96){
+                pair(48, 12);
+            }
+            pair(32, 8);
+        }
+        pair(16, 4);
+    }
+    pair(0, 0);
+    return avalanche(acc);
+}
+
+/*
+Long inputs, scalar reference.
+Per 64-byte stripe, for each of the 8 lanes with d = the lane's 8 input bytes and dk = d ^ key:
+    acc[lane] += low32(dk) * high32(dk)     (32x32->64: one vector instruction for 4 lanes)
+    acc[lane ^ 1] += d                      (keeps the raw input so no information is lost in the multiply)
+Every 16 stripes: acc = (acc ^ (acc >> 47) ^ scrambleKey) * prime32_1.
+The last (partial) stripe is the 64 bytes ending at the end of the input, overlapping what was already read.
+*/
+static inline void accumulateScalar(uint64_t* acc, const unsigned char* stripe, const uint64_t* keys){
+    for(size_t lane = 0; lane < lanes; lane++){
+        uint64_t d = read64(stripe + 8 * lane);
+        uint64_t dk = d ^ keys[lane];
+        acc[lane ^ 1] += d;
+        acc[lane] += (dk & 0xFFFFFFFFULL) * (dk >> 32);
+    }
+}
+
+static inline void scrambleScalar(uint64_t* acc){
+    for(size_t lane = 0; lane < lanes; lane++){
+        uint64_t a = acc[lane];
+        acc[lane] = (a ^ (a >> 47) ^ longKeys.scrambleKeys[lane]) * prime32_1;
+    }
+}
+
+static void initAccumulators(uint64_t* acc, uint64_t seed){
+    for(size_t lane = 0; lane < lanes; lane++){
+        acc[lane] = longKeys.mergeKeys[lane] ^ (lane & 1 ? seed : ~seed);
+    }
+}
+
+static uint64_t mergeAccumulators(const uint64_t* acc, size_t length, uint64_t seed){
+    uint64_t result = length * prime64_1 ^ seed;
+    for(size_t lane = 0; lane < lanes; lane += 2){
+        result += foldedMultiply(acc[lane] ^ longKeys.mergeKeys[lane], acc[lane + 1] ^ longKeys.mergeKeys[lane + 1]);
+    }
+    return avalanche(result);
+}
+
+uint64_t myHashLongScalar(const void* data, size_t length, uint64_t seed){
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t acc[lanes];
+    initAccumulators(acc, seed);
+    size_t stripes = (length - 1) / stripeSize; // Full stripes before the final one
+    for(size_t s = 0; s < stripes; s++){
+        accumulateScalar(acc, p + s * stripeSize, longKeys.stripeKeys[s % stripesPerBlock]);
+        if(s % stripesPerBlock == stripesPerBlock - 1){
+            scrambleScalar(acc);
+        }
+    }
+    accumulateScalar(acc, p + length - stripeSize, longKeys.stripeKeys[stripesPerBlock - 1]);
+    return mergeAccumulators(acc, length, seed);
+}
+
+#if SIMD_X86
+TARGET_AVX2 static inline __m256i accumulateAvx2(__m256i acc, const unsigned char* p, const uint64_t* keys){
+    __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i dk = _mm256_xor_si256(d, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys)));
+    __m256i product = _mm256_mul_epu32(dk, _mm256_srli_epi64(dk, 32));
+    __m256i swapped = _mm256_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)); // lane ^ 1: swap the 64-bit halves of each 128-bit half
+    return _mm256_add_epi64(acc, _mm256_add_epi64(product, swapped));
+}
+
+TARGET_AVX2 static inline __m256i scrambleAvx2(__m256i acc, const uint64_t* keys){
+    __m256i mixed = _mm256_xor_si256(_mm256_xor_si256(acc, _mm256_srli_epi64(acc, 47)),
+                                     _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys)));
+    // 64-bit * 32-bit prime from two 32x32->64 multiplies
+    __m256i prime = _mm256_set1_epi64x(prime32_1);
+    __m256i low = _mm256_mul_epu32(mixed, prime);
+    __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(mixed, 32), prime);
+    return _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+}
+
+TARGET_AVX2 uint64_t myHashLongAvx2(const void* data, size_t length, uint64_t seed){
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    alignas(32) uint64_t acc[lanes];
+    initAccumulators(acc, seed);
+    __m256i acc0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(acc));
+    __m256i acc1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(acc + 4));
+    size_t stripes = (length - 1) / stripeSize;
+    for(size_t s = 0; s < stripes; s++){
+        const unsigned char* stripe = p + s * stripeSize;
+        const uint64_t* keys = longKeys.stripeKeys[s % stripesPerBlock];
+        acc0 = accumulateAvx2(acc0, stripe, keys);
+        acc1 = accumulateAvx2(acc1, stripe + 32, keys + 4);
+        if(s % stripesPerBlock == stripesPerBlock - 1){
+            acc0 = scrambleAvx2(acc0, longKeys.scrambleKeys);
+            acc1 = scrambleAvx2(acc1, longKeys.scrambleKeys + 4);
+        }
+    }
+    const unsigned char* last = p + length - stripeSize;
+    acc0 = accumulateAvx2(acc0, last, longKeys.stripeKeys[stripesPerBlock - 1]);
+    acc1 = accumulateAvx2(acc1, last + 32, longKeys.stripeKeys[stripesPerBlock - 1] + 4);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(acc), acc0);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(acc + 4), acc1);
+    return mergeAccumulators(acc, length, seed);
+}
+#else
+uint64_t myHashLongAvx2(const void* data, size_t length, uint64_t seed){ return myHashLongScalar(data, length, seed); }
+#endif
+
+typedef uint64_t (*HashLongFn)(const void*, size_t, uint64_t);
+
+static HashLongFn selectHashLong(){
+#if SIMD_X86
+    if(cpuFeatures().avx2) return myHashLongAvx2;
+#endif
+    return myHashLongScalar;
+}
+
+static std::atomic<HashLongFn> hashLongImpl{nullptr};
+
+uint64_t myHash(const void* data, size_t length, uint64_t seed){
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    if(length <= 16){
+        return hashShort(p, length, seed);
+    }
+    if(length <= 128){
+        return hashMedium(p, length, seed);
+    }
+    HashLongFn impl = hashLongImpl.load(std::memory_order_relaxed);
+    if(!impl){
+        impl = selectHashLong();
+        hashLongImpl.store(impl, std::memory_order_relaxed);
+    }
+    return impl(p, length, seed);
+}
+
+/*
+Batch form for Arrow-style rows. Hashing rows one by one mispredicts the length-class branches whenever short and
+medium rows are mixed, and each misprediction costs more than the hash itself. Rows are therefore first bucketed by
+class (a branch-free pass), then every bucket is hashed in its own loop: 4..16 and 17..128 byte rows with branch-free
+versions of hashShort/hashMedium whose rows are independent, so several multiply chains overlap.
+The values are exactly myHash's.
+*/
+static inline uint64_t hashShortBranchless(const unsigned char* p, size_t length, uint64_t seed){
+    size_t middle = (length >> 3) << 2; // 4..16 bytes only
+    uint64_t a = (read32(p) << 32) | read32(p + middle);
+    uint64_t b = (read32(p + length - 4) << 32) | read32(p + length - 4 - middle);
+    return foldedMultiply(foldedMultiply(a ^ wyp1, b ^ seed ^ wyp0) ^ length, wyp1 ^ seed);
+}
+
+static inline uint64_t hashMediumBranchless(const unsigned char* p, size_t length, uint64_t seed){
+    const uint64_t* keys = longKeys.mediumKeys;
+    uint64_t acc = length * prime64_1 + seed;
+    for(size_t pair = 0; pair < 4; pair++){
+        // Pair j is used when length > 32 j; an unused pair rereads pair 0 (in bounds) and is masked out
+        uint64_t used = 0 - static_cast<uint64_t>(pair == 0 || length > 32 * pair);
+        size_t front = 16 * pair & used;
+        const unsigned char* back = p + length - 16 - front;
+        size_t k = 4 * pair;
+        acc += used & foldedMultiply(read64(p + front) ^ (keys[k] + seed), read64(p + front + 8) ^ (keys[k + 1] - seed));
+        acc += used & foldedMultiply(read64(back) ^ (keys[k + 2] + seed), read64(back + 8) ^ (keys[k + 3] - seed));
+    }
+    return avalanche(acc);
+}
+
+void myHashRows(const char* blob, const uint32_t* offsets, size_t rows, uint64_t* out, uint64_t seed){
+    const unsigned char* base = reinterpret_cast<const unsigned char*>(blob);
+    constexpr size_t chunk = 256;
+    uint32_t buckets[4][chunk]; // 0..3, 4..16, 17..128, above 128 bytes
+    for(size_t first = 0; first < rows; first += chunk){
+        size_t count = rows - first < chunk ? rows - first : chunk;
+        size_t filled[4] = {0, 0, 0, 0};
+        for(size_t i = 0; i < count; i++){
+            uint32_t length = offsets[first + i + 1] - offsets[first + i];
+            size_t bucket = (length > 3) + (length > 16) + (length > 128);
+            buckets[bucket][filled[bucket]++] = static_cast<uint32_t>(first + i);
+        }
+        for(size_t i = 0; i < filled[1]; i++){
+            uint32_t row = buckets[1][i];
+            out[row] = hashShortBranchless(base + offsets[row], offsets[row + 1] - offsets[row], seed);
+        }
+        for(size_t i = 0; i < filled[2]; i++){
+            uint32_t row = buckets[2][i];
+            out[row] = hashMediumBranchless(base + offsets[row], offsets[row + 1] - offsets[row], seed);
+        }
+        for(size_t i = 0; i < filled[0]; i++){
+            uint32_t row = buckets[0][i];
+            out[row] = hashShort(base + offsets[row], offsets[row + 1] - offsets[row], seed);
+        }
+        for(size_t i = 0; i < filled[3]; i++){
+            uint32_t row = buckets[3][i];
+            out[row] = myHash(base + offsets[row], offsets[row + 1] - offsets[row], seed);
+        }
+    }
+}
+
+const char* myHashKernelName(){
+    return selectHashLong() == myHashLongAvx2 ? "avx2" : "scalar";
+}
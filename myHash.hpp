@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/*
+Fast non-cryptographic 64-bit hash of a byte range (wyhash / XXH3 family), used by String::hash(), the intern table
+and StringColumn.
+
+    0..16 bytes   : two overlapping loads folded with one 64x64->128 multiply (wyhash),
+    17..128 bytes : 16-byte pairs taken from both ends, each folded with a 128-bit multiply (XXH3 mid-size),
+    above 128     : eight 64-bit accumulators fed a 64-byte stripe at a time with 32x32->64 multiplies,
+                    scrambled every 1 KiB (XXH3 long). This part is vectorized (AVX2, chosen at runtime);
+                    the scalar kernel computes exactly the same value, so hashes never depend on the CPU.
+
+Not suitable where an attacker controls the input AND can observe hashes (no secret key); use a keyed hash there.
+The results are stable within a build but are not a persistence format.
+*/
+uint64_t myHash(const void* data, size_t length, uint64_t seed = 0);
+
+/*
+out[i] = myHash of row i for rows stored Arrow-style: row i is blob[offsets[i], offsets[i + 1]), offsets has rows + 1
+entries (see StringColumn). Rows are grouped by length class and hashed without per-row branches, which avoids the
+branch mispredictions a myHash loop takes when short and medium rows are mixed.
+*/
+void myHashRows(const char* blob, const uint32_t* offsets, size_t rows, uint64_t* out, uint64_t seed = 0);
+
+// The long-input kernels, exposed for tests and benchmarks (AVX2 must only be called when the CPU supports it)
+uint64_t myHashLongScalar(const void* data, size_t length, uint64_t seed);
+uint64_t myHashLongAvx2(const void* data, size_t length, uint64_t seed);
+
+// Name of the kernel selected for long inputs ("avx2" or "scalar")
+const char* myHashKernelName();
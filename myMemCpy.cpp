@@ -1,6 +1,18 @@
-#include <iostream>
-#include <string>
-using namespace std;
+#include "myMemCpy.hpp"
+#include "cpuFeatures.hpp"
+#include "instrumentation.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <unistd.h>
+
+#if defined(__GNUC__) && !defined(__clang__)
+// Stops GCC from recognizing the byte loops below as memcpy/memmove and replacing them with a libc call
+#define KEEP_BYTE_LOOP __attribute__((optimize("no-tree-loop-distribute-patterns")))
+#else
+#define KEEP_BYTE_LOOP
+#endif
+
 /*
 memcpy copies exactly n bytes from source to destination. 
 I cast both void* pointers to unsigned char* because I need byte-level access and 
@@ -8,7 +20,7 @@ pointer arithmetic in one-byte increments. The source is const because it must n
 The function returns the original destination pointer. memcpy requires the source and destination
  ranges not to overlap; if they overlap, memmove should be used.
 */
-void* myMemCpy(void* dest, const void* src,size_t n){
+KEEP_BYTE_LOOP void* myMemCpyScalar(void* dest, const void* src,size_t n){
     
     unsigned char* d = static_cast<unsigned char*>(dest);
     const unsigned char* s = static_cast<const unsigned char*>(src);
@@ -18,7 +30,7 @@ void* myMemCpy(void* dest, const void* src,size_t n){
     return dest; // Return the destination pointer because memcpy returns the destination pointer
 }
     
-void* myMemMove(void *dest, const void *src, size_t n) {
+KEEP_BYTE_LOOP void* myMemMoveScalar(void *dest, const void *src, size_t n) {
 
     unsigned char* d = static_cast<unsigned char*>(dest);
     const unsigned char* s = static_cast<const unsigned char*>(src);
@@ -34,17 +46,356 @@ void* myMemMove(void *dest, const void *src, size_t n) {
     }
     return dest; // Return the destination pointer because memmove returns the destination pointer
 }
-int main(){
-
-    int src = 5;
-    int* dest = new int();
-    cout << "Value of dest before memcpy: " << *dest << endl; 
-    myMemCpy(dest,&src,sizeof(src));   // Copy sizeof(int) bytes from src to dest
-    cout << "Value of dest after memcpy: " << *dest << endl; // Output the value of dest after memcpy
-    char* dest2 = nullptr; // Allocate memory for dest2
-    const char* src2 = "Hello, World!";
-    myMemCpy(dest2,src2,50); // Copy the string including the null terminator
-    cout << "Value of dest2 after memcpy: " << dest2 << endl; // Output the value of dest2 after memcpy
-    delete dest; // Free the allocated memory for dest
-    delete[] dest2; // Free the allocated memory for dest2
-}
\ No newline at end of file
+
+/*
+Small copies (0..64 bytes): overlapping loads.
+Instead of a loop, a copy of n bytes with 8 <= n <= 16 is done as two 8-byte moves: the first 8 bytes and the LAST 8
+bytes. For n < 16 the two moves overlap in the middle, which is harmless because both write the same values.
+The same trick with 16-byte vectors covers 16..32 and 32..64 bytes, so every size is at most 4 loads + 4 stores and
+one or two well-predicted branches.
+All loads happen before any store, so the small path is also correct for overlapping ranges (memmove).
+*/
+template <typename T>
+static inline T loadUnaligned(const unsigned char* p){
+    T value;
+    std::memcpy(&value, p, sizeof(T)); // Fixed-size memcpy compiles to a single load
+    return value;
+}
+
+template <typename T>
+static inline void storeUnaligned(unsigned char* p, T value){
+    std::memcpy(p, &value, sizeof(T));
+}
+
+#if SIMD_X86
+using Block16 = __m128i;
+static inline Block16 load16(const unsigned char* p){ return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+static inline void store16(unsigned char* p, Block16 v){ _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+#else
+struct Block16 { uint64_t low, high; };
+static inline Block16 load16(const unsigned char* p){ return {loadUnaligned<uint64_t>(p), loadUnaligned<uint64_t>(p + 8)}; }
+static inline void store16(unsigned char* p, Block16 v){ storeUnaligned(p, v.low); storeUnaligned(p + 8, v.high); }
+#endif
+
+static inline void copySmall(unsigned char* d, const unsigned char* s, size_t n){
+    if(n >= 32){
+        Block16 a = load16(s), b = load16(s + 16), c = load16(s + n - 32), e = load16(s + n - 16);
+        store16(d, a); store16(d + 16, b); store16(d + n - 32, c); store16(d + n - 16, e);
+    }
+    else if(n >= 16){
+        Block16 a = load16(s), b = load16(s + n - 16);
+        store16(d, a); store16(d + n - 16, b);
+    }
+    else if(n >= 8){
+        uint64_t a = loadUnaligned<uint64_t>(s), b = loadUnaligned<uint64_t>(s + n - 8);
+        storeUnaligned(d, a); storeUnaligned(d + n - 8, b);
+    }
+    else if(n >= 4){
+        uint32_t a = loadUnaligned<uint32_t>(s), b = loadUnaligned<uint32_t>(s + n - 4);
+        storeUnaligned(d, a); storeUnaligned(d + n - 4, b);
+    }
+    else if(n >= 2){
+        uint16_t a = loadUnaligned<uint16_t>(s), b = loadUnaligned<uint16_t>(s + n - 2);
+        storeUnaligned(d, a); storeUnaligned(d + n - 2, b);
+    }
+    else if(n == 1){
+        d[0] = s[0];
+    }
+}
+
+/*
+Medium and large copies (n > 64): vector loops.
+    1. Load the first and last vector of the source into registers up front.
+    2. Loop over the destination from its first ALIGNED address: aligned stores never split a cache line, unaligned
+       loads from the source are cheap on modern CPUs.
+    3. Store the saved first/last vectors at the end; they cover the unaligned head and the partial tail.
+Saving head and tail before the loop and storing them last is what makes the same loops correct for memmove:
+    - forward loop (dest < src): every load reads ahead of every store done so far,
+    - backward loop (dest > src): the mirror image, walking down from the end.
+The streaming variant uses non-temporal stores, which write around the cache. After a huge copy the cache still
+holds the caller's working set instead of the copied bytes. sfence orders the streaming stores before later stores.
+*/
+using CopyFn = void (*)(unsigned char*, const unsigned char*, size_t);
+
+static void copyForwardScalar(unsigned char* d, const unsigned char* s, size_t n){ myMemMoveScalar(d, s, n); }
+static void copyBackwardScalar(unsigned char* d, const unsigned char* s, size_t n){ myMemMoveScalar(d, s, n); }
+
+#if SIMD_X86
+static void copyForwardSse2(unsigned char* d, const unsigned char* s, size_t n){
+    __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+    __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + n - 16));
+    unsigned char* end = d + n;
+    size_t skip = 16 - (reinterpret_cast<uintptr_t>(d) & 15);
+    unsigned char* dp = d + skip;
+    const unsigned char* sp = s + skip;
+    while(end - dp > 64){
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sp));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sp + 16));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sp + 32));
+        __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sp + 48));
+        _mm_store_si128(reinterpret_cast<__m128i*>(dp), a);
+        _mm_store_si128(reinterpret_cast<__m128i*>(dp + 16), b);
+        _mm_store_si128(reinterpret_cast<__m128i*>(dp + 32), c);
+        _mm_store_si128(reinterpret_cast<__m128i*>(dp + 48), e);
+        dp += 64;
+        sp += 64;
+    }
+    while(end - dp > 16){
+        _mm_store_si128(reinterpret_cast<__m128i*>(dp), _mm_loadu_si128(reinterpret_cast<const __m128i*>(sp)));
+        dp += 16;
+        sp += 16;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(end - 16), tail);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d), head);
+}
+
+static void copyBackwardSse2(unsigned char* d, const unsigned char* s, size_t n){
+    __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+    __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + n - 16));
+    unsigned char* dp = reinterpret_cast<unsigned char*>(reinterpret_cast<uintptr_t>(d + n) & ~uintptr_t(15));
+    const unsigned char* sp = s + (dp - d);
+    while(dp - d > 16){
+        dp -= 16;
+        sp -= 16;
+        _mm_store_si128(reinterpret_cast<__m128i*>(dp), _mm_loadu_si128(reinterpret_cast<const __m128i*>(sp)));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d + n - 16), tail);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d), head);
+}
+
+static void copyStreamingSse2(unsigned char* d, const unsigned char* s, size_t n){
+    __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+    __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + n - 16));
+    unsigned char* end = d + n;
+    size_t skip = 16 - (reinterpret_cast<uintptr_t>(d) & 15);
+    unsigned char* dp = d + skip;
+    const unsigned char* sp = s + skip;
+    while(end - dp > 16){
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dp), _mm_loadu_si128(reinterpret_cast<const __m128i*>(sp)));
+        dp += 16;
+        sp += 16;
+    }
+    _mm_sfence();
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(end - 16), tail);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d), head);
+}
+
+TARGET_AVX2 static void copyForwardAvx2(unsigned char* d, const unsigned char* s, size_t n){
+    __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+    __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + n - 32));
+    unsigned char* end = d + n;
+    size_t skip = 32 - (reinterpret_cast<uintptr_t>(d) & 31);
+    unsigned char* dp = d + skip;
+    const unsigned char* sp = s + skip;
+    while(end - dp > 128){
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sp));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sp + 32));
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sp + 64));
+        __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sp + 96));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(dp), a);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(dp + 32), b);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(dp + 64), c);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(dp + 96), e);
+        dp += 128;
+        sp += 128;
+    }
+    while(end - dp > 32){
+        _mm256_store_si256(reinterpret_cast<__m256i*>(dp), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sp)));
+        dp += 32;
+        sp += 32;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(end - 32), tail);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), head);
+}
+
+TARGET_AVX2 static void copyBackwardAvx2(unsigned char* d, const unsigned char* s, size_t n){
+    __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+    __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + n - 32));
+    unsigned char* dp = reinterpret_cast<unsigned char*>(reinterpret_cast<uintptr_t>(d + n) & ~uintptr_t(31));
+    const unsigned char* sp = s + (dp - d);
+    while(dp - d > 128){
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sp - 32));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sp - 64));
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sp - 96));
+        __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sp - 128));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(dp - 32), a);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(dp - 64), b);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(dp - 96), c);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(dp - 128), e);
+        dp -= 128;
+        sp -= 128;
+    }
+    while(dp - d > 32){
+        dp -= 32;
+        sp -= 32;
+        _mm256_store_si256(reinterpret_cast<__m256i*>(dp), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sp)));
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + n - 32), tail);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), head);
+}
+
+TARGET_AVX2 static void copyStreamingAvx2(unsigned char* d, const unsigned char* s, size_t n){
+    __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+    __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + n - 32));
+    unsigned char* end = d + n;
+    size_t skip = 32 - (reinterpret_cast<uintptr_t>(d) & 31);
+    unsigned char* dp = d + skip;
+    const unsigned char* sp = s + skip;
+    while(end - dp > 128){
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sp));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sp + 32));
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sp + 64));
+        __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sp + 96));
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dp), a);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dp + 32), b);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dp + 64), c);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dp + 96), e);
+        dp += 128;
+        sp += 128;
+    }
+    while(end - dp > 32){
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dp), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sp)));
+        dp += 32;
+        sp += 32;
+    }
+    _mm_sfence();
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(end - 32), tail);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), head);
+}
+#endif
+
+/*
+Runtime dispatch: the kernel set is chosen once, on the first copy larger than 64 bytes, from the CPU features.
+Small copies never go through the dispatcher.
+*/
+struct CopyKernels {
+    CopyFn forward;
+    CopyFn backward;
+    CopyFn streaming;
+    const char* name;
+};
+
+static const CopyKernels scalarKernels = {copyForwardScalar, copyBackwardScalar, copyForwardScalar, "scalar"};
+#if SIMD_X86
+static const CopyKernels sse2Kernels = {copyForwardSse2, copyBackwardSse2, copyStreamingSse2, "sse2"};
+static const CopyKernels avx2Kernels = {copyForwardAvx2, copyBackwardAvx2, copyStreamingAvx2, "avx2"};
+#endif
+
+static const CopyKernels* selectCopyKernels(){
+#if SIMD_X86
+    const CpuFeatures& cpu = cpuFeatures();
+    if(cpu.avx2) return &avx2Kernels;
+    if(cpu.sse2) return &sse2Kernels;
+#endif
+    return &scalarKernels;
+}
+
+static std::atomic<const CopyKernels*> activeKernelsPtr{nullptr};
+
+static const CopyKernels* activeKernels(){
+    const CopyKernels* kernels = activeKernelsPtr.load(std::memory_order_relaxed);
+    if(!kernels){
+        kernels = selectCopyKernels();
+        activeKernelsPtr.store(kernels, std::memory_order_relaxed);
+    }
+    return kernels;
+}
+
+static size_t defaultNonTemporalThreshold(){
+    long cacheSize = -1;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    cacheSize = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if(cacheSize <= 0){
+        cacheSize = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    }
+#endif
+    if(cacheSize <= 0){
+        return size_t(4) << 20; // 4 MiB
+    }
+    return static_cast<size_t>(cacheSize) / 2;
+}
+
+static std::atomic<size_t> nonTemporalThreshold{0}; // 0 = not computed yet
+
+size_t myMemCpyNonTemporalThreshold(){
+    size_t threshold = nonTemporalThreshold.load(std::memory_order_relaxed);
+    if(threshold == 0){
+        threshold = defaultNonTemporalThreshold();
+        nonTemporalThreshold.store(threshold, std::memory_order_relaxed);
+    }
+    return threshold;
+}
+
+void setMyMemCpyNonTemporalThreshold(size_t bytes){
+    nonTemporalThreshold.store(bytes > 64 ? bytes : 65, std::memory_order_relaxed);
+}
+
+const char* myMemCpyKernelName(){
+    return activeKernels()->name;
+}
+
+// The memcpy engine shared by myMemCpy and the non-overlapping case of myMemMove (so each call is counted once)
+static void copyNonOverlapping(unsigned char* d, const unsigned char* s, size_t n){
+    if(n <= 64){
+        copySmall(d, s, n);
+    }
+    else if(n >= myMemCpyNonTemporalThreshold()){
+        activeKernels()->streaming(d, s, n);
+    }
+    else{
+        activeKernels()->forward(d, s, n);
+    }
+}
+
+void* myMemCpy(void* dest, const void* src,size_t n){
+    INSTRUMENT_COUNT(MemCpyCalls);
+    INSTRUMENT_ADD(MemCpyBytes, n);
+    copyNonOverlapping(static_cast<unsigned char*>(dest), static_cast<const unsigned char*>(src), n);
+    return dest; // Return the destination pointer because memcpy returns the destination pointer
+}
+
+void* myMemCpyNonTemporal(void* dest, const void* src, size_t n){
+    INSTRUMENT_COUNT(MemCpyCalls);
+    INSTRUMENT_ADD(MemCpyBytes, n);
+    unsigned char* d = static_cast<unsigned char*>(dest);
+    const unsigned char* s = static_cast<const unsigned char*>(src);
+    if(n <= 64){
+        copySmall(d, s, n);
+    }
+    else{
+        activeKernels()->streaming(d, s, n);
+    }
+    return dest;
+}
+
+/*
+memmove only needs a direction when the ranges actually overlap. Comparing d < s alone (as the scalar version does)
+would send non-overlapping copies down the backward loop, which prefetchers handle worse.
+Addresses are compared as integers because comparing pointers into different objects is unspecified in C++.
+*/
+void* myMemMove(void *dest, const void *src, size_t n) {
+    INSTRUMENT_COUNT(MemMoveCalls);
+    INSTRUMENT_ADD(MemMoveBytes, n);
+    unsigned char* d = static_cast<unsigned char*>(dest);
+    const unsigned char* s = static_cast<const unsigned char*>(src);
+    if(n <= 64){
+        copySmall(d, s, n); // Loads everything before storing, so overlap is fine
+        return dest;
+    }
+    uintptr_t dAddr = reinterpret_cast<uintptr_t>(d);
+    uintptr_t sAddr = reinterpret_cast<uintptr_t>(s);
+    if(dAddr == sAddr){
+        return dest;
+    }
+    if(dAddr + n <= sAddr || sAddr + n <= dAddr){
+        copyNonOverlapping(d, s, n); // No overlap: full memcpy engine, including streaming stores
+        return dest;
+    }
+    if(dAddr < sAddr){
+        activeKernels()->forward(d, s, n);
+    }
+    else{
+        activeKernels()->backward(d, s, n);
+    }
+    return dest; // Return the destination pointer because memmove returns the destination pointer
+}
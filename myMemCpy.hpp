@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+
+/*
+Memory copy primitives.
+myMemCpy/myMemMove pick a strategy by size (see myMemCpy.cpp):
+    0..64 bytes        : branch-light overlapping loads, no loop
+    64 B .. threshold  : vector loop (AVX2 or SSE2, chosen at runtime) with aligned stores
+    >= threshold       : non-temporal (streaming) stores that bypass the cache
+The Scalar versions are the original byte loops, kept as the portable fallback and test oracle.
+*/
+
+void* myMemCpy(void* dest, const void* src, size_t n);
+void* myMemMove(void* dest, const void* src, size_t n);
+
+void* myMemCpyScalar(void* dest, const void* src, size_t n);
+void* myMemMoveScalar(void* dest, const void* src, size_t n);
+
+/*
+Copies at or above this size use non-temporal stores so a large copy does not evict the working set from the cache.
+Defaults to half of the last-level cache (4 MiB if the cache size cannot be queried).
+*/
+size_t myMemCpyNonTemporalThreshold();
+void setMyMemCpyNonTemporalThreshold(size_t bytes);
+
+// Always uses non-temporal stores (for copies known to be too large to benefit from the cache)
+void* myMemCpyNonTemporal(void* dest, const void* src, size_t n);
+
+// Name of the vector kernel selected by the dispatcher ("avx2", "sse2" or "scalar")
+const char* myMemCpyKernelName();
+
+/*
+Multi-threaded copies for very large buffers (see myMemCpyParallel.cpp).
+The range is split into page-aligned chunks that a persistent worker pool copies concurrently; the calling thread
+works too. threads == 0 means one thread per hardware thread. Copies smaller than the parallel threshold simply call
+myMemCpy/myMemMove: below a few MiB, waking the workers costs more than it saves.
+myMemMoveParallel handles overlapping ranges (see the comment on it for how).
+*/
+void* myMemCpyParallel(void* dest, const void* src, size_t n, size_t threads = 0);
+void* myMemMoveParallel(void* dest, const void* src, size_t n, size_t threads = 0);
+
+size_t myMemCpyParallelThreshold();
+void setMyMemCpyParallelThreshold(size_t bytes);
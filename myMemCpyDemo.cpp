@@ -0,0 +1,221 @@
+/*
+Demo and self-check for the memory copy primitives in myMemCpy.cpp and their companions in myMemOps.cpp.
+Build: g++ -std=c++20 -O2 -pthread myMemCpyDemo.cpp myMemCpy.cpp myMemCpyParallel.cpp myMemOps.cpp -o myMemCpyDemo
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <unistd.h>
+#include "myMemCpy.hpp"
+#include "myMemOps.hpp"
+#include <sys/mman.h>
+using namespace std;
+
+static void fillPattern(vector<unsigned char>& buffer, unsigned seed){
+    for(size_t i = 0; i < buffer.size(); i++){
+        buffer[i] = static_cast<unsigned char>((i * 131 + seed) & 0xFF);
+    }
+}
+
+/*
+Checks myMemCpy/myMemMove against the scalar oracle:
+    - every size 0..600 at several source/destination misalignments (covers the small path and the vector loops),
+    - overlapping moves in both directions with every distance 1..80,
+    - a copy above the non-temporal threshold.
+*/
+static bool checkCopies(){
+    bool ok = true;
+    vector<unsigned char> src(1024), dst(1024), expected(1024);
+    fillPattern(src, 7);
+    for(size_t n = 0; n <= 600; n++){
+        for(size_t srcOffset = 0; srcOffset < 64; srcOffset += 13){
+            for(size_t dstOffset = 0; dstOffset < 64; dstOffset += 9){
+                fillPattern(dst, 3);
+                expected = dst;
+                myMemCpyScalar(expected.data() + dstOffset, src.data() + srcOffset, n);
+                myMemCpy(dst.data() + dstOffset, src.data() + srcOffset, n);
+                if(dst != expected){ cout << "myMemCpy mismatch n=" << n << "\n"; ok = false; }
+            }
+        }
+    }
+    for(size_t n = 0; n <= 600; n += 7){
+        for(size_t distance = 1; distance <= 80; distance++){
+            for(int direction = 0; direction < 2; direction++){
+                size_t from = direction ? distance : 100;
+                size_t to = direction ? 100 : distance;
+                fillPattern(dst, static_cast<unsigned>(n));
+                expected = dst;
+                myMemMoveScalar(expected.data() + to, expected.data() + from, n);
+                myMemMove(dst.data() + to, dst.data() + from, n);
+                if(dst != expected){ cout << "myMemMove mismatch n=" << n << " distance=" << distance << "\n"; ok = false; }
+            }
+        }
+    }
+    size_t big = myMemCpyNonTemporalThreshold() + 12345;
+    vector<unsigned char> bigSrc(big + 1), bigDst(big + 1, 0);
+    fillPattern(bigSrc, 11);
+    myMemCpy(bigDst.data() + 1, bigSrc.data(), big);
+    if(memcmp(bigDst.data() + 1, bigSrc.data(), big) != 0){ cout << "streaming copy mismatch\n"; ok = false; }
+    return ok;
+}
+
+/*
+Checks myMemCpyParallel/myMemMoveParallel with a lowered parallel threshold so that buffers of a few MiB exercise
+the chunking: several thread counts, an unaligned destination, and overlapping moves both ways with distances
+above the threshold (round-based) and below it (single-thread fallback).
+*/
+static bool checkParallelCopies(){
+    bool ok = true;
+    size_t savedThreshold = myMemCpyParallelThreshold();
+    setMyMemCpyParallelThreshold(1 << 20);
+    size_t n = (size_t(9) << 20) + 777;
+    vector<unsigned char> src(n + 64), dst(n + 64), expected(n + 64);
+    fillPattern(src, 5);
+    for(size_t threads : {0, 1, 2, 3, 8}){
+        for(size_t dstOffset : {0, 1, 33}){
+            fillPattern(dst, 9);
+            expected = dst;
+            myMemCpyScalar(expected.data() + dstOffset, src.data() + 3, n);
+            myMemCpyParallel(dst.data() + dstOffset, src.data() + 3, n, threads);
+            if(dst != expected){ cout << "myMemCpyParallel mismatch threads=" << threads << "\n"; ok = false; }
+        }
+    }
+    size_t moveLength = size_t(6) << 20;
+    for(size_t distance : {size_t(1000), (size_t(1) << 20) + 5, (size_t(2) << 20) + 4096}){
+        for(int direction = 0; direction < 2; direction++){
+            size_t from = direction ? 0 : distance;
+            size_t to = direction ? distance : 0;
+            fillPattern(dst, static_cast<unsigned>(distance));
+            expected = dst;
+            myMemMoveScalar(expected.data() + to, expected.data() + from, moveLength);
+            myMemMoveParallel(dst.data() + to, dst.data() + from, moveLength, 4);
+            if(dst != expected){ cout << "myMemMoveParallel mismatch distance=" << distance << "\n"; ok = false; }
+        }
+    }
+    setMyMemCpyParallelThreshold(savedThreshold);
+    return ok;
+}
+
+static int sign(int value){ return (value > 0) - (value < 0); }
+
+/*
+Checks myMemSet/myMemCmp/myMemChr/myMemRChr/myMemChrAny against the scalar oracles:
+    - every size 0..300 at several misalignments, a fill above the non-temporal threshold,
+    - compares with a single differing byte at every position (and equal inputs),
+    - searches with the target at every position and absent,
+    - inputs ending right before an inaccessible page, so a vector load past the end would crash.
+*/
+static bool checkMemOps(){
+    bool ok = true;
+    vector<unsigned char> buffer(1024), expected(1024);
+    for(size_t n = 0; n <= 300; n++){
+        for(size_t offset = 0; offset < 64; offset += 7){
+            fillPattern(buffer, 1);
+            expected = buffer;
+            myMemSetScalar(expected.data() + offset, 0xA5, n);
+            myMemSet(buffer.data() + offset, 0xA5, n);
+            if(buffer != expected){ cout << "myMemSet mismatch n=" << n << "\n"; ok = false; }
+        }
+    }
+    size_t big = myMemCpyNonTemporalThreshold() + 999;
+    vector<unsigned char> bigBuffer(big + 2, 1);
+    myMemSet(bigBuffer.data() + 1, 7, big);
+    if(bigBuffer[0] != 1 || bigBuffer[big + 1] != 1 || bigBuffer[1] != 7 || bigBuffer[big] != 7 || std::count(bigBuffer.begin(), bigBuffer.end(), 7) != static_cast<long>(big)){
+        cout << "streaming myMemSet mismatch\n"; ok = false;
+    }
+
+    vector<char> a(400), b(400);
+    for(size_t n = 0; n <= 300; n++){
+        for(size_t offset : {0, 3}){
+            for(size_t i = 0; i < a.size(); i++) a[i] = b[i] = static_cast<char>('a' + i % 23);
+            if(myMemCmp(a.data() + offset, b.data() + offset + 0, n) != 0){ cout << "myMemCmp equal mismatch n=" << n << "\n"; ok = false; }
+            for(size_t at = 0; at < n; at++){
+                for(int delta : {1, -1, 0x80}){
+                    b[offset + at] = static_cast<char>(a[offset + at] + delta);
+                    if(sign(myMemCmp(a.data() + offset, b.data() + offset, n)) != sign(myMemCmpScalar(a.data() + offset, b.data() + offset, n))){
+                        cout << "myMemCmp mismatch n=" << n << " at=" << at << "\n"; ok = false;
+                    }
+                    b[offset + at] = a[offset + at];
+                }
+            }
+        }
+    }
+
+    // Every byte value against sets mixing both halves of the byte range (the AVX2 set search splits on the top bit)
+    char everyByte[256];
+    for(int b = 0; b < 256; b++) everyByte[b] = static_cast<char>(b);
+    const char wideSet[] = "\x01\x7f\x80\xff\x41\xc1\x0f\x8f\x20\xa0\x5a\xda\x33\xb3\x66\xe6\x99\x19";
+    for(size_t setLength = 2; setLength < sizeof(wideSet); setLength++){
+        for(size_t start = 0; start < 256; start++){
+            if(myMemChrAny(everyByte + start, 256 - start, wideSet, setLength) != myMemChrAnyScalar(everyByte + start, 256 - start, wideSet, setLength)){
+                cout << "myMemChrAny mismatch start=" << start << " set=" << setLength << "\n"; ok = false;
+            }
+        }
+    }
+
+    vector<char> text(400, 'x');
+    const char set[] = "0123456789abcdef?";
+    for(size_t n = 0; n <= 300; n++){
+        for(size_t offset : {0, 1, 17}){
+            const char* p = text.data() + offset;
+            for(size_t at = 0; at <= n; at++){ // at == n: absent
+                if(at < n) text[offset + at] = '?';
+                if(at + 1 < n) text[offset + n - 1] = '7'; // a second hit for the reverse search and the set
+                for(size_t setLength : {size_t(1), size_t(3), size_t(16), size_t(17)}){
+                    const char* hitSet = set + sizeof(set) - 1 - setLength; // always ends with '?'
+                    if(myMemChrAny(p, n, hitSet, setLength) != myMemChrAnyScalar(p, n, hitSet, setLength)){
+                        cout << "myMemChrAny mismatch n=" << n << " set=" << setLength << "\n"; ok = false;
+                    }
+                }
+                if(myMemChr(p, n, '?') != myMemChrScalar(p, n, '?') || myMemRChr(p, n, '?') != myMemRChrScalar(p, n, '?')
+                   || myMemRChr(p, n, '7') != myMemRChrScalar(p, n, '7')){
+                    cout << "myMemChr/myMemRChr mismatch n=" << n << " at=" << at << "\n"; ok = false;
+                }
+                std::fill(text.begin(), text.end(), 'x');
+            }
+        }
+    }
+
+    long pageSize = sysconf(_SC_PAGESIZE);
+    void* pages = mmap(nullptr, 2 * pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(pages != MAP_FAILED){
+        char* guard = static_cast<char*>(pages) + pageSize;
+        mprotect(guard, pageSize, PROT_NONE);
+        std::fill(guard - pageSize, guard, 'x');
+        for(size_t n = 0; n <= 64; n++){
+            const char* p = guard - n;
+            bool found = myMemChr(p, n, 'y') != nullptr || myMemRChr(p, n, 'y') != nullptr || myMemChrAny(p, n, "yz", 2) != nullptr
+                         || myMemCmp(p, p, n) != 0;
+            if(found){ cout << "page-end search mismatch n=" << n << "\n"; ok = false; }
+        }
+        munmap(pages, 2 * pageSize);
+    }
+    return ok;
+}
+
+int main(){
+
+    int src = 5;
+    int* dest = new int();
+    cout << "Value of dest before memcpy: " << *dest << endl; 
+    myMemCpy(dest,&src,sizeof(src));   // Copy sizeof(int) bytes from src to dest
+    cout << "Value of dest after memcpy: " << *dest << endl; // Output the value of dest after memcpy
+    const char* src2 = "Hello, World!";
+    char* dest2 = new char[strlen(src2) + 1]; // Destination must own enough memory for the copy
+    myMemCpy(dest2,src2,strlen(src2) + 1); // Copy the string including the null terminator
+    cout << "Value of dest2 after memcpy: " << dest2 << endl; // Output the value of dest2 after memcpy
+    delete dest; // Free the allocated memory for dest
+    delete[] dest2; // Free the allocated memory for dest2
+
+    char overlap[] = "abcdefghij";
+    myMemMove(overlap + 2, overlap, 5); // Overlapping ranges: dest after src
+    cout << "After myMemMove(overlap + 2, overlap, 5): " << overlap << endl;
+
+    cout << "Selected kernel: " << myMemCpyKernelName() << ", non-temporal threshold: " << myMemCpyNonTemporalThreshold() << " bytes" << endl;
+    cout << "Copies agree with scalar oracle: " << (checkCopies() ? "yes" : "NO") << endl;
+    cout << "Parallel copies agree with scalar oracle: " << (checkParallelCopies() ? "yes" : "NO") << endl;
+    cout << "Fill/compare/search kernel: " << myMemOpsKernelName() << ", agree with scalar oracle: " << (checkMemOps() ? "yes" : "NO") << endl;
+    return 0;
+}
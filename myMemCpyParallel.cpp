@@ -0,0 +1,222 @@
+#include "myMemCpy.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+Why more than one thread?
+A single core can only keep a limited number of cache misses in flight, which caps one thread's copy bandwidth well
+below what the memory controllers deliver. Splitting a multi-GB copy over several cores multiplies the number of
+outstanding requests until the memory bus, not the core, is the limit.
+
+Design:
+    - Chunks are aligned to destination page boundaries (4 KiB), so no two threads ever write the same page or cache
+      line, and each chunk is large (2 MiB) so the per-chunk overhead is negligible.
+    - Threads pull chunk indices from an atomic counter, so a thread that is slowed down (preempted, remote NUMA
+      node) simply copies fewer chunks instead of holding everyone up.
+    - Workers live in a pool created on first use and reused by every later call: spawning threads per call would
+      cost tens of microseconds each.
+    - Copies above the non-temporal threshold use streaming stores in every chunk, like the single-thread path.
+*/
+
+static constexpr size_t pageSize = 4096;
+static constexpr size_t chunkSize = size_t(2) << 20; // 2 MiB, a multiple of pageSize
+
+static std::atomic<size_t> parallelThreshold{size_t(4) << 20}; // 4 MiB
+
+size_t myMemCpyParallelThreshold(){
+    return parallelThreshold.load(std::memory_order_relaxed);
+}
+
+void setMyMemCpyParallelThreshold(size_t bytes){
+    parallelThreshold.store(bytes, std::memory_order_relaxed);
+}
+
+// One parallel copy: chunk k covers [chunkStart(k), chunkStart(k + 1)) of the destination
+struct CopyJob {
+    unsigned char* dest;
+    const unsigned char* src;
+    size_t n;
+    size_t firstChunkEnd; // bytes up to the first page boundary after dest + chunkSize
+    size_t chunkCount;
+    bool streaming;
+    std::atomic<size_t> nextChunk{0};
+
+    size_t chunkStart(size_t k) const {
+        if(k == 0) return 0;
+        size_t start = firstChunkEnd + (k - 1) * chunkSize;
+        return start < n ? start : n;
+    }
+
+    // Copies chunks until none are left
+    void work(){
+        for(size_t k = nextChunk.fetch_add(1, std::memory_order_relaxed); k < chunkCount; k = nextChunk.fetch_add(1, std::memory_order_relaxed)){
+            size_t begin = chunkStart(k);
+            size_t end = chunkStart(k + 1);
+            if(streaming){
+                myMemCpyNonTemporal(dest + begin, src + begin, end - begin);
+            }
+            else{
+                myMemCpy(dest + begin, src + begin, end - begin);
+            }
+        }
+    }
+};
+
+class CopyThreadPool {
+    public:
+        static CopyThreadPool& instance(){
+            static CopyThreadPool pool;
+            return pool;
+        }
+
+        // Runs job on the calling thread plus (threads - 1) pool workers and returns when every chunk is copied
+        void run(CopyJob& job, size_t threads){
+            std::lock_guard<std::mutex> serialize(runMutex); // One parallel copy at a time uses the pool
+            size_t helpers = std::min(threads - 1, job.chunkCount - 1);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                while(workers.size() < helpers){
+                    size_t index = workers.size();
+                    workers.emplace_back([this, index]{ workerLoop(index); });
+                }
+                current = &job;
+                participants = helpers;
+                finished = 0;
+                generation++;
+            }
+            wake.notify_all();
+            job.work(); // The caller copies too instead of just waiting
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [&]{ return finished == participants; });
+            current = nullptr;
+        }
+
+        ~CopyThreadPool(){
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for(std::thread& worker : workers){
+                worker.join();
+            }
+        }
+
+    private:
+        CopyThreadPool() = default;
+
+        void workerLoop(size_t index){
+            uint64_t seenGeneration = 0;
+            std::unique_lock<std::mutex> lock(mutex);
+            while(true){
+                wake.wait(lock, [&]{ return stopping || generation != seenGeneration; });
+                if(stopping){
+                    return;
+                }
+                seenGeneration = generation;
+                if(index >= participants){
+                    continue; // Not needed for this copy
+                }
+                CopyJob* job = current;
+                lock.unlock();
+                job->work();
+                lock.lock();
+                if(++finished == participants){
+                    done.notify_one();
+                }
+            }
+        }
+
+        std::mutex runMutex;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        std::vector<std::thread> workers;
+        CopyJob* current = nullptr;
+        size_t participants = 0;
+        size_t finished = 0;
+        uint64_t generation = 0;
+        bool stopping = false;
+};
+
+static size_t resolveThreads(size_t threads){
+    if(threads == 0){
+        threads = std::thread::hardware_concurrency();
+    }
+    return threads == 0 ? 1 : threads;
+}
+
+// Parallel copy of non-overlapping ranges, no threshold check
+static void copyChunked(unsigned char* d, const unsigned char* s, size_t n, size_t threads){
+    CopyJob job;
+    job.dest = d;
+    job.src = s;
+    job.n = n;
+    // First chunk ends on a page boundary of the destination; every later boundary is then page-aligned too
+    uintptr_t firstBoundary = (reinterpret_cast<uintptr_t>(d) + chunkSize + pageSize - 1) & ~uintptr_t(pageSize - 1);
+    job.firstChunkEnd = std::min<size_t>(firstBoundary - reinterpret_cast<uintptr_t>(d), n);
+    job.chunkCount = 1 + (n - job.firstChunkEnd + chunkSize - 1) / chunkSize;
+    job.streaming = n >= myMemCpyNonTemporalThreshold();
+    if(threads <= 1 || job.chunkCount == 1){
+        job.work();
+        return;
+    }
+    CopyThreadPool::instance().run(job, threads);
+}
+
+void* myMemCpyParallel(void* dest, const void* src, size_t n, size_t threads){
+    threads = resolveThreads(threads);
+    if(n < myMemCpyParallelThreshold() || threads == 1){
+        return myMemCpy(dest, src, n);
+    }
+    copyChunked(static_cast<unsigned char*>(dest), static_cast<const unsigned char*>(src), n, threads);
+    return dest;
+}
+
+/*
+Overlapping ranges cannot simply be copied chunk by chunk in parallel: a chunk written by one thread may be the
+source another thread has not read yet.
+With distance = |dest - src|, any span of at most `distance` bytes has a destination that does not overlap its own
+source, so it can be copied in parallel safely. The move is therefore done in rounds of `distance` bytes:
+    - dest < src: rounds go from the front to the back; a round only overwrites source bytes that earlier rounds
+      have already consumed,
+    - dest > src: the mirror image, from the back to the front.
+Each round is a parallel copy. If the distance is below the parallel threshold the rounds would be too small to
+parallelize, and the single-thread myMemMove is used instead.
+*/
+void* myMemMoveParallel(void* dest, const void* src, size_t n, size_t threads){
+    threads = resolveThreads(threads);
+    unsigned char* d = static_cast<unsigned char*>(dest);
+    const unsigned char* s = static_cast<const unsigned char*>(src);
+    uintptr_t dAddr = reinterpret_cast<uintptr_t>(d);
+    uintptr_t sAddr = reinterpret_cast<uintptr_t>(s);
+    if(dAddr == sAddr){
+        return dest;
+    }
+    bool overlapping = dAddr < sAddr + n && sAddr < dAddr + n;
+    if(!overlapping){
+        return myMemCpyParallel(dest, src, n, threads);
+    }
+    size_t distance = dAddr < sAddr ? sAddr - dAddr : dAddr - sAddr;
+    if(n < myMemCpyParallelThreshold() || distance < myMemCpyParallelThreshold() || threads == 1){
+        return myMemMove(dest, src, n);
+    }
+    if(dAddr < sAddr){
+        for(size_t offset = 0; offset < n; offset += distance){
+            copyChunked(d + offset, s + offset, std::min(distance, n - offset), threads);
+        }
+    }
+    else{
+        for(size_t remaining = n; remaining > 0;){
+            size_t round = std::min(distance, remaining);
+            remaining -= round;
+            copyChunked(d + remaining, s + remaining, round, threads);
+        }
+    }
+    return dest;
+}
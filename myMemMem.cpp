@@ -0,0 +1,347 @@
+#include "myMemMem.hpp"
+#include "myMemOps.hpp"
+#include "cpuFeatures.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+static constexpr size_t notFound = SIZE_MAX;
+
+/*
+Two-Way string matching (Crochemore & Perrin, 1991).
+The needle is split at a "critical factorization" needle = left + right. Each alignment first matches right from left
+to right, then left from right to left. On a mismatch the shift is computed from the period of the needle, and for
+periodic needles the part already known to match is remembered, so no haystack byte is compared more than a constant
+number of times: O(n + m) time, O(1) extra space, no tables.
+
+The algorithm is written against a byte accessor so the very same code also searches BACKWARDS (for rfind): the
+ReverseBytes accessor presents haystack and needle reversed, and the first match in the reversed haystack is the last
+match in the original one.
+*/
+struct ForwardBytes {
+    const unsigned char* first;
+    unsigned char operator[](size_t i) const { return first[i]; }
+};
+
+struct ReverseBytes {
+    const unsigned char* last; // index 0 is the last byte, index 1 the one before it, ...
+    unsigned char operator[](size_t i) const { return *(last - i); }
+};
+
+// Returns the start of the right half of the critical factorization and stores the period of the right half.
+template <typename Bytes>
+static size_t criticalFactorization(Bytes needle, size_t n, size_t* period){
+    // Maximal suffix for the ordering a < b. maxSuffix starts at SIZE_MAX so that maxSuffix + k wraps to k - 1.
+    size_t maxSuffix = SIZE_MAX, j = 0, k = 1, p = 1;
+    while(j + k < n){
+        unsigned char a = needle[j + k];
+        unsigned char b = needle[maxSuffix + k];
+        if(a < b){ j += k; k = 1; p = j - maxSuffix; }
+        else if(a == b){ if(k != p) ++k; else { j += p; k = 1; } }
+        else{ maxSuffix = j++; k = p = 1; }
+    }
+    *period = p;
+
+    // Maximal suffix for the reversed ordering
+    size_t maxSuffixRev = SIZE_MAX;
+    j = 0; k = 1; p = 1;
+    while(j + k < n){
+        unsigned char a = needle[j + k];
+        unsigned char b = needle[maxSuffixRev + k];
+        if(b < a){ j += k; k = 1; p = j - maxSuffixRev; }
+        else if(a == b){ if(k != p) ++k; else { j += p; k = 1; } }
+        else{ maxSuffixRev = j++; k = p = 1; }
+    }
+
+    // The larger of the two maximal suffixes gives a critical factorization
+    if(maxSuffixRev + 1 < maxSuffix + 1){
+        return maxSuffix + 1;
+    }
+    *period = p;
+    return maxSuffixRev + 1;
+}
+
+// Index of the first occurrence of needle (n >= 1) in haystack (h >= n), or notFound
+template <typename Bytes>
+static size_t twoWaySearch(Bytes haystack, size_t h, Bytes needle, size_t n){
+    size_t period = 0;
+    size_t suffix = criticalFactorization(needle, n, &period);
+
+    bool periodic = true; // needle[0, suffix) == needle[period, period + suffix)
+    for(size_t i = 0; i < suffix; i++){
+        if(needle[i] != needle[i + period]){
+            periodic = false;
+            break;
+        }
+    }
+
+    size_t j = 0;
+    if(periodic){
+        // memory = length of the needle prefix already known to match at the current alignment
+        size_t memory = 0;
+        while(j <= h - n){
+            size_t i = suffix > memory ? suffix : memory;
+            while(i < n && needle[i] == haystack[i + j]) ++i;
+            if(n <= i){
+                i = suffix - 1;
+                while(memory < i + 1 && needle[i] == haystack[i + j]) --i;
+                if(i + 1 < memory + 1){
+                    return j;
+                }
+                j += period;
+                memory = n - period;
+            }
+            else{
+                j += i - suffix + 1;
+                memory = 0;
+            }
+        }
+    }
+    else{
+        period = (suffix > n - suffix ? suffix : n - suffix) + 1;
+        while(j <= h - n){
+            size_t i = suffix;
+            while(i < n && needle[i] == haystack[i + j]) ++i;
+            if(n <= i){
+                i = suffix - 1;
+                while(i != SIZE_MAX && needle[i] == haystack[i + j]) --i;
+                if(i == SIZE_MAX){
+                    return j;
+                }
+                j += period;
+            }
+            else{
+                j += i - suffix + 1;
+            }
+        }
+    }
+    return notFound;
+}
+
+const char* myMemMemTwoWay(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength){
+    if(needleLength == 0){
+        return haystack;
+    }
+    if(needleLength > haystackLength){
+        return nullptr;
+    }
+    size_t index = twoWaySearch(ForwardBytes{reinterpret_cast<const unsigned char*>(haystack)}, haystackLength,
+                                ForwardBytes{reinterpret_cast<const unsigned char*>(needle)}, needleLength);
+    return index == notFound ? nullptr : haystack + index;
+}
+
+const char* myMemRMemTwoWay(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength){
+    if(needleLength == 0){
+        return haystack + haystackLength;
+    }
+    if(needleLength > haystackLength){
+        return nullptr;
+    }
+    size_t index = twoWaySearch(ReverseBytes{reinterpret_cast<const unsigned char*>(haystack) + haystackLength - 1}, haystackLength,
+                                ReverseBytes{reinterpret_cast<const unsigned char*>(needle) + needleLength - 1}, needleLength);
+    return index == notFound ? nullptr : haystack + (haystackLength - index - needleLength);
+}
+
+/*
+Vector first/last-byte filter.
+For 32 candidate start positions at once, compare the haystack byte at the start with needle[0] AND the byte at
+start + n - 1 with needle[n - 1]. Only positions where both match (rare for real text) are verified with myMemCmp.
+Checking the LAST byte too is what makes the filter selective: a common first letter alone would pass too often.
+
+The filter alone is O(n * m) on adversarial input ("aaaa" in "aaaaaaaa"). verifiedBytes counts the verification work;
+once it grows beyond a constant times the bytes scanned, the rest of the haystack is handed to Two-Way, which keeps the
+whole search linear.
+*/
+static bool filterIsFailing(size_t verifiedBytes, size_t scannedBytes){
+    return verifiedBytes > 2 * scannedBytes + 4096;
+}
+
+// Verifies the candidate starts blockStart + (set bits of mask), lowest first
+static const char* verifyCandidates(const char* haystack, size_t blockStart, uint32_t mask, const char* needle, size_t n, size_t& verifiedBytes){
+    while(mask){
+        size_t position = blockStart + __builtin_ctz(mask);
+        if(myMemCmp(haystack + position + 1, needle + 1, n - 2) == 0){
+            return haystack + position;
+        }
+        verifiedBytes += n;
+        mask &= mask - 1;
+    }
+    return nullptr;
+}
+
+#if SIMD_X86
+static const char* memMemSse2(const char* haystack, size_t h, const char* needle, size_t n){
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[n - 1]);
+    size_t verifiedBytes = 0;
+    size_t i = 0;
+    for(; i + n - 1 + 16 <= h; i += 16){
+        __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+        __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i + n - 1));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast))));
+        if(mask){
+            if(const char* found = verifyCandidates(haystack, i, mask, needle, n, verifiedBytes)){
+                return found;
+            }
+            if(filterIsFailing(verifiedBytes, i)){
+                i += 16;
+                break;
+            }
+        }
+    }
+    return myMemMemTwoWay(haystack + i, h - i, needle, n);
+}
+
+static const char* memRMemSse2(const char* haystack, size_t h, const char* needle, size_t n){
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[n - 1]);
+    size_t verifiedBytes = 0;
+    size_t end = h - n + 1; // candidate starts still to check: [0, end)
+    while(end >= 16){
+        size_t i = end - 16;
+        __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+        __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i + n - 1));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast))));
+        while(mask){
+            unsigned bit = 31 - __builtin_clz(mask); // highest candidate first
+            if(myMemCmp(haystack + i + bit + 1, needle + 1, n - 2) == 0){
+                return haystack + i + bit;
+            }
+            verifiedBytes += n;
+            mask &= ~(1u << bit);
+        }
+        end = i;
+        if(filterIsFailing(verifiedBytes, h - n + 1 - end)){
+            break;
+        }
+    }
+    return myMemRMemTwoWay(haystack, end + n - 1, needle, n);
+}
+
+TARGET_AVX2 static const char* memMemAvx2(const char* haystack, size_t h, const char* needle, size_t n){
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[n - 1]);
+    size_t verifiedBytes = 0;
+    size_t i = 0;
+    // 64 candidate starts per iteration; blocks without any candidate cost 4 loads and one branch
+    for(; i + n - 1 + 64 <= h; i += 64){
+        __m256i firstA = _mm256_cmpeq_epi8(first, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i)));
+        __m256i lastA = _mm256_cmpeq_epi8(last, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i + n - 1)));
+        __m256i firstB = _mm256_cmpeq_epi8(first, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i + 32)));
+        __m256i lastB = _mm256_cmpeq_epi8(last, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i + 32 + n - 1)));
+        __m256i candidatesA = _mm256_and_si256(firstA, lastA);
+        __m256i candidatesB = _mm256_and_si256(firstB, lastB);
+        if(_mm256_testz_si256(_mm256_or_si256(candidatesA, candidatesB), _mm256_set1_epi8(-1))){
+            continue;
+        }
+        if(const char* found = verifyCandidates(haystack, i, static_cast<uint32_t>(_mm256_movemask_epi8(candidatesA)), needle, n, verifiedBytes)){
+            return found;
+        }
+        if(const char* found = verifyCandidates(haystack, i + 32, static_cast<uint32_t>(_mm256_movemask_epi8(candidatesB)), needle, n, verifiedBytes)){
+            return found;
+        }
+        if(filterIsFailing(verifiedBytes, i)){
+            i += 64;
+            return myMemMemTwoWay(haystack + i, h - i, needle, n);
+        }
+    }
+    for(; i + n - 1 + 32 <= h; i += 32){
+        __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i));
+        __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i + n - 1));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast))));
+        if(const char* found = verifyCandidates(haystack, i, mask, needle, n, verifiedBytes)){
+            return found;
+        }
+    }
+    return myMemMemTwoWay(haystack + i, h - i, needle, n);
+}
+
+TARGET_AVX2 static const char* memRMemAvx2(const char* haystack, size_t h, const char* needle, size_t n){
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[n - 1]);
+    size_t verifiedBytes = 0;
+    size_t end = h - n + 1;
+    while(end >= 32){
+        size_t i = end - 32;
+        __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i));
+        __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i + n - 1));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast))));
+        while(mask){
+            unsigned bit = 31 - __builtin_clz(mask);
+            if(myMemCmp(haystack + i + bit + 1, needle + 1, n - 2) == 0){
+                return haystack + i + bit;
+            }
+            verifiedBytes += n;
+            mask &= ~(1u << bit);
+        }
+        end = i;
+        if(filterIsFailing(verifiedBytes, h - n + 1 - end)){
+            break;
+        }
+    }
+    return myMemRMemTwoWay(haystack, end + n - 1, needle, n);
+}
+#endif
+
+using SearchFn = const char* (*)(const char*, size_t, const char*, size_t);
+
+struct SearchKernels {
+    SearchFn forward;
+    SearchFn backward;
+};
+
+static const SearchKernels twoWayKernels = {myMemMemTwoWay, myMemRMemTwoWay};
+#if SIMD_X86
+static const SearchKernels sse2Kernels = {memMemSse2, memRMemSse2};
+static const SearchKernels avx2Kernels = {memMemAvx2, memRMemAvx2};
+#endif
+
+static const SearchKernels* selectSearchKernels(){
+#if SIMD_X86
+    const CpuFeatures& cpu = cpuFeatures();
+    if(cpu.avx2) return &avx2Kernels;
+    if(cpu.sse2) return &sse2Kernels;
+#endif
+    return &twoWayKernels;
+}
+
+static std::atomic<const SearchKernels*> activeSearchKernels{nullptr};
+
+static const SearchKernels* searchKernels(){
+    const SearchKernels* kernels = activeSearchKernels.load(std::memory_order_relaxed);
+    if(!kernels){
+        kernels = selectSearchKernels();
+        activeSearchKernels.store(kernels, std::memory_order_relaxed);
+    }
+    return kernels;
+}
+
+const char* myMemMem(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength){
+    if(needleLength == 0){
+        return haystack;
+    }
+    if(needleLength > haystackLength){
+        return nullptr;
+    }
+    if(needleLength == 1){
+        return myMemChr(haystack, haystackLength, needle[0]);
+    }
+    return searchKernels()->forward(haystack, haystackLength, needle, needleLength);
+}
+
+const char* myMemRMem(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength){
+    if(needleLength == 0){
+        return haystack + haystackLength;
+    }
+    if(needleLength > haystackLength){
+        return nullptr;
+    }
+    if(needleLength == 1){
+        return myMemRChr(haystack, haystackLength, needle[0]);
+    }
+    return searchKernels()->backward(haystack, haystackLength, needle, needleLength);
+}
+
+const char* myFindFirstOf(const char* text, size_t textLength, const char* set, size_t setLength){
+    return myMemChrAny(text, textLength, set, setLength);
+}
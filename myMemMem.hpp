@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+
+/*
+Substring search primitives (used by String::find and friends).
+
+myMemMem/myMemRMem return the first/last position of needle in haystack, or nullptr if there is none.
+Both run a vector first/last-byte filter (AVX2 or SSE2, chosen at runtime) and fall back to the Two-Way algorithm
+when the filter produces too many false candidates, so the worst case stays linear in the haystack length.
+myMemMemTwoWay/myMemRMemTwoWay are the scalar Two-Way searches: the fallback and the test oracle.
+*/
+
+const char* myMemMem(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength);
+const char* myMemRMem(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength);
+
+const char* myMemMemTwoWay(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength);
+const char* myMemRMemTwoWay(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength);
+
+// First byte of text that is one of the setLength bytes in set, or nullptr (same as myMemChrAny in myMemOps.hpp)
+const char* myFindFirstOf(const char* text, size_t textLength, const char* set, size_t setLength);
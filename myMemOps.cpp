@@ -0,0 +1,666 @@
+#include "myMemOps.hpp"
+#include "myMemCpy.hpp"
+#include "cpuFeatures.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__GNUC__) && !defined(__clang__)
+// Stops GCC from recognizing the byte loop in myMemSetScalar as memset and replacing it with a libc call
+#define KEEP_BYTE_LOOP __attribute__((optimize("no-tree-loop-distribute-patterns")))
+#else
+#define KEEP_BYTE_LOOP
+#endif
+
+KEEP_BYTE_LOOP void* myMemSetScalar(void* dest, int c, size_t n){
+    unsigned char* d = static_cast<unsigned char*>(dest);
+    for(size_t i = 0; i < n; i++){
+        d[i] = static_cast<unsigned char>(c);
+    }
+    return dest;
+}
+
+int myMemCmpScalar(const void* lhs, const void* rhs, size_t n){
+    const unsigned char* a = static_cast<const unsigned char*>(lhs);
+    const unsigned char* b = static_cast<const unsigned char*>(rhs);
+    for(size_t i = 0; i < n; i++){
+        if(a[i] != b[i]){
+            return static_cast<int>(a[i]) - static_cast<int>(b[i]);
+        }
+    }
+    return 0;
+}
+
+const char* myMemChrScalar(const char* text, size_t length, char c){
+    for(size_t i = 0; i < length; i++){
+        if(text[i] == c){
+            return text + i;
+        }
+    }
+    return nullptr;
+}
+
+const char* myMemRChrScalar(const char* text, size_t length, char c){
+    while(length > 0){
+        if(text[--length] == c){
+            return text + length;
+        }
+    }
+    return nullptr;
+}
+
+// 256-entry membership table: one lookup per byte whatever the size of the set
+const char* myMemChrAnyScalar(const char* text, size_t length, const char* set, size_t setLength){
+    bool inSet[256] = {};
+    for(size_t k = 0; k < setLength; k++){
+        inSet[static_cast<unsigned char>(set[k])] = true;
+    }
+    for(size_t i = 0; i < length; i++){
+        if(inSet[static_cast<unsigned char>(text[i])]){
+            return text + i;
+        }
+    }
+    return nullptr;
+}
+
+/*
+Small inputs: overlapping general-purpose register loads and stores, as in myMemCpy's small path.
+A fill of 8 <= n <= 16 bytes is two 8-byte stores of the broadcast byte (the first and the LAST 8 bytes), a compare
+of 8 <= n <= 16 bytes is two 8-byte loads per side. No vector registers are touched, so these paths cost the same
+whether the caller is an AVX2 or an SSE2 kernel (no AVX-SSE transition).
+*/
+template <typename T>
+static inline T loadUnaligned(const unsigned char* p){
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+template <typename T>
+static inline void storeUnaligned(unsigned char* p, T value){
+    std::memcpy(p, &value, sizeof(T));
+}
+
+static inline void setSmall(unsigned char* d, unsigned char c, size_t n){
+    uint64_t v = 0x0101010101010101ull * c;
+    if(n >= 16){
+        storeUnaligned(d, v); storeUnaligned(d + 8, v); storeUnaligned(d + n - 16, v); storeUnaligned(d + n - 8, v);
+    }
+    else if(n >= 8){
+        storeUnaligned(d, v); storeUnaligned(d + n - 8, v);
+    }
+    else if(n >= 4){
+        storeUnaligned(d, static_cast<uint32_t>(v)); storeUnaligned(d + n - 4, static_cast<uint32_t>(v));
+    }
+    else if(n >= 2){
+        storeUnaligned(d, static_cast<uint16_t>(v)); storeUnaligned(d + n - 2, static_cast<uint16_t>(v));
+    }
+    else if(n == 1){
+        d[0] = c;
+    }
+}
+
+// Offset of the first differing byte of two words loaded from memory (difference != 0)
+static inline size_t firstDifference(uint64_t difference){
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return static_cast<size_t>(__builtin_clzll(difference)) / 8;
+#else
+    return static_cast<size_t>(__builtin_ctzll(difference)) / 8;
+#endif
+}
+
+template <typename T>
+static inline bool compareWord(const unsigned char* a, const unsigned char* b, int& result){
+    T x = loadUnaligned<T>(a), y = loadUnaligned<T>(b);
+    if(x == y){
+        return false;
+    }
+    size_t i = firstDifference(static_cast<uint64_t>(x ^ y));
+    result = static_cast<int>(a[i]) - static_cast<int>(b[i]);
+    return true;
+}
+
+// n <= 16
+static inline int cmpSmall(const unsigned char* a, const unsigned char* b, size_t n){
+    int result = 0;
+    if(n >= 8){
+        if(compareWord<uint64_t>(a, b, result) || compareWord<uint64_t>(a + n - 8, b + n - 8, result)) return result;
+    }
+    else if(n >= 4){
+        if(compareWord<uint32_t>(a, b, result) || compareWord<uint32_t>(a + n - 4, b + n - 4, result)) return result;
+    }
+    else{
+        for(size_t i = 0; i < n; i++){
+            if(a[i] != b[i]){
+                return static_cast<int>(a[i]) - static_cast<int>(b[i]);
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+Vector kernels.
+A load that runs past the end of the input is only safe within the same page. For inputs shorter than one vector the
+byte search kernels load a whole vector when it does not cross a page boundary and mask off the lanes past the end
+(so the bytes after the input can never produce a hit), otherwise they fall back to the byte loop.
+Longer inputs are never read out of bounds: the first and last vectors are loaded unaligned and may overlap the
+aligned middle; a hit in the overlap cannot be missed or reported twice because the overlapped bytes were already
+checked and found not to match.
+*/
+#if SIMD_X86
+static inline bool vectorFitsInPage(const void* p, size_t bytes){
+    return (reinterpret_cast<uintptr_t>(p) & 4095) <= 4096 - bytes;
+}
+
+static inline int differingByte(const unsigned char* a, const unsigned char* b, size_t offset, unsigned equalMask){
+    size_t i = offset + static_cast<size_t>(__builtin_ctz(~equalMask));
+    return static_cast<int>(a[i]) - static_cast<int>(b[i]);
+}
+
+static void setSse2(unsigned char* d, unsigned char c, size_t n){
+    __m128i v = _mm_set1_epi8(static_cast<char>(c));
+    unsigned char* end = d + n;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d), v);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(end - 16), v);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 16), v);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(end - 32), v);
+    if(n <= 64){
+        return; // 33..64 bytes: four overlapping vectors, no loop
+    }
+    unsigned char* p = reinterpret_cast<unsigned char*>((reinterpret_cast<uintptr_t>(d) + 16) & ~uintptr_t(15));
+    while(end - p >= 64){
+        _mm_store_si128(reinterpret_cast<__m128i*>(p), v);
+        _mm_store_si128(reinterpret_cast<__m128i*>(p + 16), v);
+        _mm_store_si128(reinterpret_cast<__m128i*>(p + 32), v);
+        _mm_store_si128(reinterpret_cast<__m128i*>(p + 48), v);
+        p += 64;
+    }
+    while(end - p >= 16){
+        _mm_store_si128(reinterpret_cast<__m128i*>(p), v);
+        p += 16;
+    }
+}
+
+static void setStreamingSse2(unsigned char* d, unsigned char c, size_t n){
+    __m128i v = _mm_set1_epi8(static_cast<char>(c));
+    unsigned char* end = d + n;
+    unsigned char* p = reinterpret_cast<unsigned char*>((reinterpret_cast<uintptr_t>(d) + 16) & ~uintptr_t(15));
+    while(end - p >= 16){
+        _mm_stream_si128(reinterpret_cast<__m128i*>(p), v);
+        p += 16;
+    }
+    _mm_sfence();
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d), v);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(end - 16), v);
+}
+
+// n > 16
+static int cmpSse2(const unsigned char* a, const unsigned char* b, size_t n){
+    size_t i = 0;
+    for(; i + 32 <= n; i += 32){
+        __m128i eqA = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        __m128i eqB = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 16)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 16)));
+        if(_mm_movemask_epi8(_mm_and_si128(eqA, eqB)) != 0xFFFF){
+            unsigned maskA = static_cast<unsigned>(_mm_movemask_epi8(eqA));
+            return maskA != 0xFFFF ? differingByte(a, b, i, maskA) : differingByte(a, b, i + 16, static_cast<unsigned>(_mm_movemask_epi8(eqB)));
+        }
+    }
+    for(; i + 16 <= n; i += 16){
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)))));
+        if(mask != 0xFFFF){
+            return differingByte(a, b, i, mask);
+        }
+    }
+    if(i < n){
+        size_t last = n - 16;
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + last)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + last)))));
+        if(mask != 0xFFFF){
+            return differingByte(a, b, last, mask);
+        }
+    }
+    return 0;
+}
+
+ALLOW_OVERREAD static inline unsigned matchMask16(const char* p, __m128i v){
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), v)));
+}
+
+ALLOW_OVERREAD static const char* chrSse2(const char* p, size_t n, char c){
+    __m128i v = _mm_set1_epi8(c);
+    if(n < 16){
+        if(!vectorFitsInPage(p, 16)){
+            return myMemChrScalar(p, n, c);
+        }
+        unsigned mask = matchMask16(p, v) & ((1u << n) - 1);
+        return mask ? p + __builtin_ctz(mask) : nullptr;
+    }
+    if(unsigned mask = matchMask16(p, v)){
+        return p + __builtin_ctz(mask);
+    }
+    size_t i = 16 - (reinterpret_cast<uintptr_t>(p) & 15);
+    for(; i + 64 <= n; i += 64){
+        __m128i a = _mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(p + i)), v);
+        __m128i b = _mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(p + i + 16)), v);
+        __m128i e = _mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(p + i + 32)), v);
+        __m128i f = _mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(p + i + 48)), v);
+        if(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(e, f)))){
+            uint64_t mask = static_cast<uint64_t>(_mm_movemask_epi8(a)) | static_cast<uint64_t>(_mm_movemask_epi8(b)) << 16
+                          | static_cast<uint64_t>(_mm_movemask_epi8(e)) << 32 | static_cast<uint64_t>(_mm_movemask_epi8(f)) << 48;
+            return p + i + __builtin_ctzll(mask);
+        }
+    }
+    for(; i + 16 <= n; i += 16){
+        if(unsigned mask = matchMask16(p + i, v)){
+            return p + i + __builtin_ctz(mask);
+        }
+    }
+    if(i < n){
+        if(unsigned mask = matchMask16(p + n - 16, v)){
+            return p + n - 16 + __builtin_ctz(mask);
+        }
+    }
+    return nullptr;
+}
+
+ALLOW_OVERREAD static const char* rchrSse2(const char* p, size_t n, char c){
+    __m128i v = _mm_set1_epi8(c);
+    if(n < 16){
+        if(!vectorFitsInPage(p, 16)){
+            return myMemRChrScalar(p, n, c);
+        }
+        unsigned mask = matchMask16(p, v) & ((1u << n) - 1);
+        return mask ? p + 31 - __builtin_clz(mask) : nullptr;
+    }
+    if(unsigned mask = matchMask16(p + n - 16, v)){
+        return p + n - 16 + 31 - __builtin_clz(mask);
+    }
+    size_t e = n - (reinterpret_cast<uintptr_t>(p + n) & 15); // p + e is aligned, [e, n) already checked
+    for(; e >= 16; e -= 16){
+        if(unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(p + e - 16)), v)))){
+            return p + e - 16 + 31 - __builtin_clz(mask);
+        }
+    }
+    if(e > 0){
+        if(unsigned mask = matchMask16(p, v)){ // only [0, e) can still match
+            return p + 31 - __builtin_clz(mask);
+        }
+    }
+    return nullptr;
+}
+
+// SSE2: up to 16 set bytes, every block is compared against each of them and the results ORed
+ALLOW_OVERREAD static inline unsigned anyMask16(const char* p, const __m128i* setBytes, size_t setLength){
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i hits = _mm_cmpeq_epi8(block, setBytes[0]);
+    for(size_t k = 1; k < setLength; k++){
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, setBytes[k]));
+    }
+    return static_cast<unsigned>(_mm_movemask_epi8(hits));
+}
+
+ALLOW_OVERREAD static const char* chrAnySse2(const char* p, size_t n, const char* set, size_t setLength){
+    if(setLength > 16){
+        return myMemChrAnyScalar(p, n, set, setLength); // SSE2 has no byte shuffle for the nibble bitmap
+    }
+    __m128i setBytes[16];
+    for(size_t k = 0; k < setLength; k++){
+        setBytes[k] = _mm_set1_epi8(set[k]);
+    }
+    if(n < 16){
+        if(!vectorFitsInPage(p, 16)){
+            return myMemChrAnyScalar(p, n, set, setLength);
+        }
+        unsigned mask = anyMask16(p, setBytes, setLength) & ((1u << n) - 1);
+        return mask ? p + __builtin_ctz(mask) : nullptr;
+    }
+    size_t i = 0;
+    for(; i + 16 <= n; i += 16){
+        if(unsigned mask = anyMask16(p + i, setBytes, setLength)){
+            return p + i + __builtin_ctz(mask);
+        }
+    }
+    if(i < n){
+        if(unsigned mask = anyMask16(p + n - 16, setBytes, setLength)){
+            return p + n - 16 + __builtin_ctz(mask);
+        }
+    }
+    return nullptr;
+}
+
+TARGET_AVX2 static void setAvx2(unsigned char* d, unsigned char c, size_t n){
+    __m256i v = _mm256_set1_epi8(static_cast<char>(c));
+    unsigned char* end = d + n;
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), v);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(end - 32), v);
+    if(n <= 64){
+        return; // 33..64 bytes: the two overlapping vectors cover everything
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 32), v);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(end - 64), v);
+    if(n <= 128){
+        return; // 65..128 bytes: four overlapping vectors, no loop
+    }
+    unsigned char* p = reinterpret_cast<unsigned char*>((reinterpret_cast<uintptr_t>(d) + 32) & ~uintptr_t(31));
+    while(end - p >= 128){
+        _mm256_store_si256(reinterpret_cast<__m256i*>(p), v);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(p + 32), v);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(p + 64), v);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(p + 96), v);
+        p += 128;
+    }
+    while(end - p >= 32){
+        _mm256_store_si256(reinterpret_cast<__m256i*>(p), v);
+        p += 32;
+    }
+}
+
+TARGET_AVX2 static void setStreamingAvx2(unsigned char* d, unsigned char c, size_t n){
+    __m256i v = _mm256_set1_epi8(static_cast<char>(c));
+    unsigned char* end = d + n;
+    unsigned char* p = reinterpret_cast<unsigned char*>((reinterpret_cast<uintptr_t>(d) + 32) & ~uintptr_t(31));
+    while(end - p >= 128){
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(p), v);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(p + 32), v);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(p + 64), v);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(p + 96), v);
+        p += 128;
+    }
+    while(end - p >= 32){
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(p), v);
+        p += 32;
+    }
+    _mm_sfence();
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), v);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(end - 32), v);
+}
+
+TARGET_AVX2 static inline unsigned equalMask32(const unsigned char* a, const unsigned char* b){
+    return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)))));
+}
+
+// n > 16
+TARGET_AVX2 static int cmpAvx2(const unsigned char* a, const unsigned char* b, size_t n){
+    if(n <= 32){
+        // Two overlapping 16-byte halves (VEX-encoded here, so no transition penalty)
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(b)))));
+        if(mask != 0xFFFF){
+            return differingByte(a, b, 0, mask);
+        }
+        size_t last = n - 16;
+        mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + last)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + last)))));
+        return mask != 0xFFFF ? differingByte(a, b, last, mask) : 0;
+    }
+    size_t i = 0;
+    // 128 bytes per iteration: XOR each pair of vectors and OR the differences; one test decides the whole block
+    for(; i + 128 <= n; i += 128){
+        __m256i x0 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        __m256i x1 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 32)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 32)));
+        __m256i x2 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 64)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 64)));
+        __m256i x3 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 96)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 96)));
+        __m256i any = _mm256_or_si256(_mm256_or_si256(x0, x1), _mm256_or_si256(x2, x3));
+        if(!_mm256_testz_si256(any, any)){
+            break; // the 32-byte loop below finds the differing byte
+        }
+    }
+    for(; i + 32 <= n; i += 32){
+        unsigned mask = equalMask32(a + i, b + i);
+        if(mask != 0xFFFFFFFFu){
+            return differingByte(a, b, i, mask);
+        }
+    }
+    if(i < n){
+        size_t last = n - 32;
+        unsigned mask = equalMask32(a + last, b + last);
+        if(mask != 0xFFFFFFFFu){
+            return differingByte(a, b, last, mask);
+        }
+    }
+    return 0;
+}
+
+TARGET_AVX2 ALLOW_OVERREAD static inline unsigned matchMask32(const char* p, __m256i v){
+    return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), v)));
+}
+
+TARGET_AVX2 ALLOW_OVERREAD static const char* chrAvx2(const char* p, size_t n, char c){
+    __m256i v = _mm256_set1_epi8(c);
+    if(n < 32){
+        if(!vectorFitsInPage(p, 32)){
+            return myMemChrScalar(p, n, c);
+        }
+        unsigned mask = matchMask32(p, v) & ((1u << n) - 1);
+        return mask ? p + __builtin_ctz(mask) : nullptr;
+    }
+    if(unsigned mask = matchMask32(p, v)){
+        return p + __builtin_ctz(mask);
+    }
+    size_t i = 32 - (reinterpret_cast<uintptr_t>(p) & 31);
+    // 128 bytes per iteration; blocks without a hit cost 4 loads, 4 compares and one test
+    for(; i + 128 <= n; i += 128){
+        __m256i a = _mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(p + i)), v);
+        __m256i b = _mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(p + i + 32)), v);
+        __m256i e = _mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(p + i + 64)), v);
+        __m256i f = _mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(p + i + 96)), v);
+        __m256i any = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(e, f));
+        if(!_mm256_testz_si256(any, any)){
+            uint64_t low = static_cast<uint32_t>(_mm256_movemask_epi8(a)) | static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(b))) << 32;
+            if(low){
+                return p + i + __builtin_ctzll(low);
+            }
+            uint64_t high = static_cast<uint32_t>(_mm256_movemask_epi8(e)) | static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(f))) << 32;
+            return p + i + 64 + __builtin_ctzll(high);
+        }
+    }
+    for(; i + 32 <= n; i += 32){
+        if(unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(p + i)), v)))){
+            return p + i + __builtin_ctz(mask);
+        }
+    }
+    if(i < n){
+        if(unsigned mask = matchMask32(p + n - 32, v)){
+            return p + n - 32 + __builtin_ctz(mask);
+        }
+    }
+    return nullptr;
+}
+
+TARGET_AVX2 ALLOW_OVERREAD static const char* rchrAvx2(const char* p, size_t n, char c){
+    __m256i v = _mm256_set1_epi8(c);
+    if(n < 32){
+        if(!vectorFitsInPage(p, 32)){
+            return myMemRChrScalar(p, n, c);
+        }
+        unsigned mask = matchMask32(p, v) & ((1u << n) - 1);
+        return mask ? p + 31 - __builtin_clz(mask) : nullptr;
+    }
+    if(unsigned mask = matchMask32(p + n - 32, v)){
+        return p + n - 32 + 31 - __builtin_clz(mask);
+    }
+    size_t e = n - (reinterpret_cast<uintptr_t>(p + n) & 31); // p + e is aligned, [e, n) already checked
+    for(; e >= 128; e -= 128){
+        __m256i a = _mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(p + e - 32)), v);
+        __m256i b = _mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(p + e - 64)), v);
+        __m256i f = _mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(p + e - 96)), v);
+        __m256i g = _mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(p + e - 128)), v);
+        __m256i any = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(f, g));
+        if(!_mm256_testz_si256(any, any)){
+            uint64_t high = static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(a))) << 32 | static_cast<uint32_t>(_mm256_movemask_epi8(b));
+            if(high){
+                return p + e - 64 + 63 - __builtin_clzll(high);
+            }
+            uint64_t low = static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(f))) << 32 | static_cast<uint32_t>(_mm256_movemask_epi8(g));
+            return p + e - 128 + 63 - __builtin_clzll(low);
+        }
+    }
+    for(; e >= 32; e -= 32){
+        if(unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(p + e - 32)), v)))){
+            return p + e - 32 + 31 - __builtin_clz(mask);
+        }
+    }
+    if(e > 0){
+        if(unsigned mask = matchMask32(p, v)){ // only [0, e) can still match
+            return p + 31 - __builtin_clz(mask);
+        }
+    }
+    return nullptr;
+}
+
+/*
+Set membership for any number of set bytes with two table lookups per byte (vpshufb), so the cost does not grow with
+the set. The 256-bit membership bitmap is stored as 16 rows indexed by the low nibble: lowHalf[L] has bit H set when
+byte (H << 4 | L) is in the set for high nibbles 0..7, highHalf[L] the same for 8..15. vpshufb yields 0 for an index
+byte with its top bit set, so looking up the byte in lowHalf and the byte ^ 0x80 in highHalf selects the right half
+for free; the row is then tested against 1 << (high nibble & 7).
+*/
+struct NibbleTables {
+    __m256i lowHalf, highHalf;
+};
+
+static inline void buildNibbleBitmap(const char* set, size_t setLength, unsigned char (&lowHalf)[16], unsigned char (&highHalf)[16]){
+    for(size_t k = 0; k < setLength; k++){
+        unsigned char byte = static_cast<unsigned char>(set[k]);
+        unsigned char bit = static_cast<unsigned char>(1u << ((byte >> 4) & 7));
+        (byte < 0x80 ? lowHalf : highHalf)[byte & 15] |= bit;
+    }
+}
+
+TARGET_AVX2 ALLOW_OVERREAD static inline unsigned anyMask32(const char* p, const NibbleTables& tables){
+    const __m256i bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                          1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i rows = _mm256_or_si256(_mm256_shuffle_epi8(tables.lowHalf, block),
+                                   _mm256_shuffle_epi8(tables.highHalf, _mm256_xor_si256(block, _mm256_set1_epi8(-128))));
+    __m256i bit = _mm256_shuffle_epi8(bits, _mm256_and_si256(_mm256_srli_epi16(block, 4), _mm256_set1_epi8(15)));
+    return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(rows, bit), bit)));
+}
+
+TARGET_AVX2 ALLOW_OVERREAD static const char* chrAnyAvx2(const char* p, size_t n, const char* set, size_t setLength){
+    alignas(16) unsigned char lowHalf[16] = {}, highHalf[16] = {};
+    buildNibbleBitmap(set, setLength, lowHalf, highHalf);
+    NibbleTables tables = {_mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(lowHalf))),
+                           _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(highHalf)))};
+    if(n < 32){
+        if(!vectorFitsInPage(p, 32)){
+            return myMemChrAnyScalar(p, n, set, setLength);
+        }
+        unsigned mask = anyMask32(p, tables) & ((1u << n) - 1);
+        return mask ? p + __builtin_ctz(mask) : nullptr;
+    }
+    size_t i = 0;
+    for(; i + 64 <= n; i += 64){
+        unsigned maskA = anyMask32(p + i, tables);
+        unsigned maskB = anyMask32(p + i + 32, tables);
+        if(maskA | maskB){
+            return maskA ? p + i + __builtin_ctz(maskA) : p + i + 32 + __builtin_ctz(maskB);
+        }
+    }
+    if(i + 32 <= n){
+        if(unsigned mask = anyMask32(p + i, tables)){
+            return p + i + __builtin_ctz(mask);
+        }
+        i += 32;
+    }
+    if(i < n){
+        if(unsigned mask = anyMask32(p + n - 32, tables)){
+            return p + n - 32 + __builtin_ctz(mask);
+        }
+    }
+    return nullptr;
+}
+#endif
+
+/*
+Runtime dispatch, as in myMemCpy.cpp: the kernel set is chosen once from the CPU features.
+set covers n > 32, cmp n > 16; the byte searches take every n >= 1 and chrAny sets of 2 or more bytes.
+*/
+struct MemOpsKernels {
+    void (*set)(unsigned char*, unsigned char, size_t);
+    void (*setStreaming)(unsigned char*, unsigned char, size_t);
+    int (*cmp)(const unsigned char*, const unsigned char*, size_t);
+    const char* (*chr)(const char*, size_t, char);
+    const char* (*rchr)(const char*, size_t, char);
+    const char* (*chrAny)(const char*, size_t, const char*, size_t);
+    const char* name;
+};
+
+static void setScalar(unsigned char* d, unsigned char c, size_t n){ myMemSetScalar(d, c, n); }
+static int cmpScalar(const unsigned char* a, const unsigned char* b, size_t n){ return myMemCmpScalar(a, b, n); }
+
+static const MemOpsKernels scalarKernels = {setScalar, setScalar, cmpScalar, myMemChrScalar, myMemRChrScalar, myMemChrAnyScalar, "scalar"};
+#if SIMD_X86
+static const MemOpsKernels sse2Kernels = {setSse2, setStreamingSse2, cmpSse2, chrSse2, rchrSse2, chrAnySse2, "sse2"};
+static const MemOpsKernels avx2Kernels = {setAvx2, setStreamingAvx2, cmpAvx2, chrAvx2, rchrAvx2, chrAnyAvx2, "avx2"};
+#endif
+
+static const MemOpsKernels* selectMemOpsKernels(){
+#if SIMD_X86
+    const CpuFeatures& cpu = cpuFeatures();
+    if(cpu.avx2) return &avx2Kernels;
+    if(cpu.sse2) return &sse2Kernels;
+#endif
+    return &scalarKernels;
+}
+
+static std::atomic<const MemOpsKernels*> activeKernelsPtr{nullptr};
+
+static const MemOpsKernels* activeKernels(){
+    const MemOpsKernels* kernels = activeKernelsPtr.load(std::memory_order_relaxed);
+    if(!kernels){
+        kernels = selectMemOpsKernels();
+        activeKernelsPtr.store(kernels, std::memory_order_relaxed);
+    }
+    return kernels;
+}
+
+const char* myMemOpsKernelName(){
+    return activeKernels()->name;
+}
+
+/*
+Streaming stores only pay off for fills far larger than any sensible threshold; checking the size first keeps the
+call into myMemCpyNonTemporalThreshold() (and the registers it forces the compiler to save) off the common path.
+*/
+static constexpr size_t streamingMinimum = size_t(64) << 10;
+
+void* myMemSet(void* dest, int c, size_t n){
+    unsigned char* d = static_cast<unsigned char*>(dest);
+    unsigned char byte = static_cast<unsigned char>(c);
+    if(n <= 32){
+        setSmall(d, byte, n);
+    }
+    else if(n >= streamingMinimum && n >= myMemCpyNonTemporalThreshold()){
+        activeKernels()->setStreaming(d, byte, n);
+    }
+    else{
+        activeKernels()->set(d, byte, n);
+    }
+    return dest;
+}
+
+int myMemCmp(const void* lhs, const void* rhs, size_t n){
+    const unsigned char* a = static_cast<const unsigned char*>(lhs);
+    const unsigned char* b = static_cast<const unsigned char*>(rhs);
+    if(n <= 16){
+        return cmpSmall(a, b, n);
+    }
+    return activeKernels()->cmp(a, b, n);
+}
+
+const char* myMemChr(const char* text, size_t length, char c){
+    return length == 0 ? nullptr : activeKernels()->chr(text, length, c);
+}
+
+const char* myMemRChr(const char* text, size_t length, char c){
+    return length == 0 ? nullptr : activeKernels()->rchr(text, length, c);
+}
+
+const char* myMemChrAny(const char* text, size_t length, const char* set, size_t setLength){
+    if(length == 0 || setLength == 0){
+        return nullptr;
+    }
+    if(setLength == 1){
+        return activeKernels()->chr(text, length, set[0]);
+    }
+    return activeKernels()->chrAny(text, length, set, setLength);
+}
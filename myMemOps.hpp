@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+
+/*
+Fill, compare and byte-search primitives, the companions of myMemCpy (see myMemOps.cpp):
+    myMemSet     : memset
+    myMemCmp     : memcmp (<0, 0, >0: the difference of the first differing bytes as unsigned char)
+    myMemChr     : first byte equal to c, or nullptr (memchr)
+    myMemRChr    : last byte equal to c, or nullptr (GNU memrchr)
+    myMemChrAny  : first byte equal to any of the setLength bytes in set, or nullptr (strpbrk without terminators)
+Each has an AVX2 and an SSE2 kernel chosen at runtime. Inputs of a few bytes are handled with overlapping
+general-purpose register loads and stores and never reach the dispatcher; the vector kernels cover an unaligned head
+and tail with one overlapping vector each instead of a byte loop, and fills of at least 64 KiB that are also at or
+above myMemCpyNonTemporalThreshold() use streaming stores like large copies.
+The Scalar versions are plain byte loops, kept as the portable fallback and test oracle.
+*/
+
+void* myMemSet(void* dest, int c, size_t n);
+int myMemCmp(const void* lhs, const void* rhs, size_t n);
+const char* myMemChr(const char* text, size_t length, char c);
+const char* myMemRChr(const char* text, size_t length, char c);
+const char* myMemChrAny(const char* text, size_t length, const char* set, size_t setLength);
+
+void* myMemSetScalar(void* dest, int c, size_t n);
+int myMemCmpScalar(const void* lhs, const void* rhs, size_t n);
+const char* myMemChrScalar(const char* text, size_t length, char c);
+const char* myMemRChrScalar(const char* text, size_t length, char c);
+const char* myMemChrAnyScalar(const char* text, size_t length, const char* set, size_t setLength);
+
+// Name of the vector kernel selected by the dispatcher ("avx2", "sse2" or "scalar")
+const char* myMemOpsKernelName();
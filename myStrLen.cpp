@@ -1,51 +1,282 @@
-#include <iostream>
-#include <string>
-using namespace std;
+#include "myStrLen.hpp"
+#include "cpuFeatures.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 
-size_t myStrlen(const char* str){
+/*
+Why byte-at-a-time is slow:
+The scalar loop does one load, one compare and one branch per character. A 64-bit register can test 8 bytes at once,
+an SSE2 register 16 and an AVX2 register 32, so the vector kernels do the same work in 1/8 to 1/32 of the iterations.
+
+Page-boundary safety:
+A string can end right before an unmapped page. Reading a whole block past the null-terminator is only safe if that
+block never crosses into the next page. Every kernel below therefore only reads blocks that are ALIGNED to their own
+size: an aligned 8/16/32-byte block always lies inside a single 4 KiB page. The first block is aligned DOWN, so it may
+start before the string; the bytes before the string are masked out.
+*/
+
+static constexpr size_t pageSize = 4096;
+
+// Byte-at-a-time reference implementation (test oracle)
+size_t myStrlenScalar(const char* str){
     const char* start = str;
     while(*str!='\0')   str++;
     return str - start;
 }
 
-char* myStrCpy(char* dest, const char* src){
+/*
+SWAR = SIMD Within A Register.
+hasZeroByte(x) is non-zero if any byte of x is 0:
+    (x - 0x01..01) borrows into the top bit of a byte only when that byte was 0 (or >= 0x81),
+    & ~x clears the bytes that had their top bit set already,
+    & 0x80..80 keeps only the top bits.
+The lowest set top bit marks the first zero byte (little-endian byte order).
+*/
+static constexpr uint64_t onesPerByte = 0x0101010101010101ULL;
+static constexpr uint64_t highBitPerByte = 0x8080808080808080ULL;
 
-    char* d = dest;
-    while(*src!= '\0'){
-        *d = *src; // Copy each character from source to destination
-        d++;
-        src++;
+static inline uint64_t hasZeroByte(uint64_t x){
+    return (x - onesPerByte) & ~x & highBitPerByte;
+}
+
+static inline uint64_t loadWord(const char* p){
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word)); // Compiles to one load, avoids strict-aliasing issues
+    return word;
+}
+
+ALLOW_OVERREAD size_t myStrlenSwar(const char* str){
+    const char* p = str;
+    // Walk byte by byte up to the first 8-byte boundary
+    while(reinterpret_cast<uintptr_t>(p) % sizeof(uint64_t) != 0){
+        if(*p == '\0') return p - str;
+        p++;
+    }
+    while(true){
+        uint64_t zeros = hasZeroByte(loadWord(p));
+        if(zeros){
+            return (p - str) + __builtin_ctzll(zeros) / 8;
+        }
+        p += sizeof(uint64_t);
     }
-    *d = '\0'; // Add null terminator at the end of the destination string
-    return dest; // Return the destination pointer
+}
 
+#if SIMD_X86
+ALLOW_OVERREAD size_t myStrlenSse2(const char* str){
+    const __m128i zero = _mm_setzero_si128();
+    uintptr_t offset = reinterpret_cast<uintptr_t>(str) & 15;
+    const char* p = str - offset; // Aligned down to 16 bytes
+    // Drop the bytes that lie before the string
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(p)), zero))) >> offset;
+    if(mask){
+        return __builtin_ctz(mask);
+    }
+    while(true){
+        p += 16;
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(p)), zero));
+        if(mask){
+            return (p - str) + __builtin_ctz(mask);
+        }
+    }
 }
 
-bool myStrCmp(const char* str1, const char* str2){
-    while(*str1 && *str2 ){
-        if(*str1 != *str2)   return false; // If characters are not equal, return false
-        str1++;
-        str2++;
+TARGET_AVX2 ALLOW_OVERREAD size_t myStrlenAvx2(const char* str){
+    const __m256i zero = _mm256_setzero_si256();
+    uintptr_t offset = reinterpret_cast<uintptr_t>(str) & 31;
+    const char* p = str - offset; // Aligned down to 32 bytes
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(p)), zero))) >> offset;
+    if(mask){
+        return __builtin_ctz(mask);
+    }
+    p += 32;
+    // One more single block if needed so the pair below starts 64-byte aligned and cannot straddle a page
+    if(reinterpret_cast<uintptr_t>(p) & 32){
+        mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*>(p)), zero)));
+        if(mask){
+            return (p - str) + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+    // Two blocks per iteration: min of both is zero exactly when either block contains a zero byte
+    while(true){
+        __m256i first = _mm256_load_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i second = _mm256_load_si256(reinterpret_cast<const __m256i*>(p + 32));
+        if(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(first, second), zero))){
+            mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(first, zero)));
+            if(mask){
+                return (p - str) + __builtin_ctz(mask);
+            }
+            mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(second, zero)));
+            return (p + 32 - str) + __builtin_ctz(mask);
+        }
+        p += 64;
     }
-    return *str1 == *str2; // If both strings are equal, return true
 }
+#else
+size_t myStrlenSse2(const char* str){ return myStrlenSwar(str); }
+size_t myStrlenAvx2(const char* str){ return myStrlenSwar(str); }
+#endif
 
-int main() {
+/*
+Three-way comparison (reference implementation).
+Bytes are compared as unsigned char, like strcmp, so that "\x80" sorts after "a".
+*/
+int myStrCompareScalar(const char* str1, const char* str2){
+    const unsigned char* a = reinterpret_cast<const unsigned char*>(str1);
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(str2);
+    while(*a && *a == *b){
+        a++;
+        b++;
+    }
+    return static_cast<int>(*a) - static_cast<int>(*b);
+}
 
-    cout <<"Length of \"Hello\" : " << myStrlen("Hello") <<"\n";
-    string s = "Hello World";
-    cout <<"Length of s : " << myStrlen(s.c_str()) << "\n";
-    const char * s2 = "Shreya Garg";
-    cout <<"Length of s2 : " << myStrlen(s2) << "\n";
-    char s3[20] = "Learning";
-    cout <<"Length of s3 : "<<myStrlen(s3) << "\n";
+/*
+Comparing two strings is harder than measuring one: the two pointers usually have DIFFERENT alignments, so we cannot
+align both. Instead each block load is unaligned, and we only do it when neither pointer is within one block of the
+end of its page. Otherwise (rare: at most once per block size per page) we step one byte.
+*/
+static inline bool blockStaysInPage(const void* p, size_t blockSize){
+    return (reinterpret_cast<uintptr_t>(p) & (pageSize - 1)) <= pageSize - blockSize;
+}
 
-    char* res = myStrCpy(s3, "Programming");
-    cout <<"s3 after copying \"Programming\" : " << s3 << "\n";
+static inline int byteDifference(const char* a, const char* b, size_t index){
+    return static_cast<int>(static_cast<unsigned char>(a[index])) - static_cast<int>(static_cast<unsigned char>(b[index]));
+}
 
-    myStrCmp("Hello", "Hello") ? cout << "\"Hello\" and \"Hello\" are equal\n" : cout << "\"Hello\" and \"Hello\" are not equal\n";
-    myStrCmp("Hello", "World") ? cout << "\"Hello\" and \"World\" are equal\n" : cout << "\"Hello\" and \"World\" are not equal\n";
-    myStrCmp("Hello", "HelloWorld") ? cout << "\"Hello\" and \"HelloWorld\" are equal\n" : cout << "\"Hello\" and \"HelloWorld\" are not equal\n";
+ALLOW_OVERREAD int myStrCompareSwar(const char* str1, const char* str2){
+    while(true){
+        if(blockStaysInPage(str1, 8) && blockStaysInPage(str2, 8)){
+            uint64_t a = loadWord(str1);
+            uint64_t b = loadWord(str2);
+            // Stop at the first differing byte OR the first null-terminator, whichever comes first
+            uint64_t zeros = hasZeroByte(a);
+            uint64_t diff = a ^ b;
+            if(zeros | diff){
+                size_t firstZero = zeros ? __builtin_ctzll(zeros) / 8 : 8;
+                size_t firstDiff = diff ? __builtin_ctzll(diff) / 8 : 8;
+                return byteDifference(str1, str2, firstZero < firstDiff ? firstZero : firstDiff);
+            }
+            str1 += 8;
+            str2 += 8;
+        }
+        else{
+            int diff = byteDifference(str1, str2, 0);
+            if(diff != 0 || *str1 == '\0') return diff;
+            str1++;
+            str2++;
+        }
+    }
+}
 
-    return 0;
-}
\ No newline at end of file
+#if SIMD_X86
+ALLOW_OVERREAD int myStrCompareSse2(const char* str1, const char* str2){
+    const __m128i zero = _mm_setzero_si128();
+    while(true){
+        if(blockStaysInPage(str1, 16) && blockStaysInPage(str2, 16)){
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str1));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str2));
+            unsigned equal = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+            unsigned nul = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, zero)));
+            unsigned stop = (~equal & 0xFFFFu) | nul;
+            if(stop){
+                return byteDifference(str1, str2, __builtin_ctz(stop));
+            }
+            str1 += 16;
+            str2 += 16;
+        }
+        else{
+            int diff = byteDifference(str1, str2, 0);
+            if(diff != 0 || *str1 == '\0') return diff;
+            str1++;
+            str2++;
+        }
+    }
+}
+
+TARGET_AVX2 ALLOW_OVERREAD int myStrCompareAvx2(const char* str1, const char* str2){
+    const __m256i zero = _mm256_setzero_si256();
+    while(true){
+        if(blockStaysInPage(str1, 32) && blockStaysInPage(str2, 32)){
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str1));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str2));
+            unsigned equal = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+            unsigned nul = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, zero)));
+            unsigned stop = ~equal | nul;
+            if(stop){
+                return byteDifference(str1, str2, __builtin_ctz(stop));
+            }
+            str1 += 32;
+            str2 += 32;
+        }
+        else{
+            int diff = byteDifference(str1, str2, 0);
+            if(diff != 0 || *str1 == '\0') return diff;
+            str1++;
+            str2++;
+        }
+    }
+}
+#else
+int myStrCompareSse2(const char* str1, const char* str2){ return myStrCompareSwar(str1, str2); }
+int myStrCompareAvx2(const char* str1, const char* str2){ return myStrCompareSwar(str1, str2); }
+#endif
+
+/*
+Runtime dispatch.
+Each public entry point calls through an atomic function pointer. It starts out pointing at a resolver, which runs
+once on the first call: it reads the CPU features, stores the best kernel into the pointer and forwards the call.
+Every later call goes straight to the chosen kernel. Because the pointer is constant-initialized, calls made from
+other static constructors (before main) are also safe.
+*/
+using StrlenFn = size_t (*)(const char*);
+using StrCompareFn = int (*)(const char*, const char*);
+
+static StrlenFn selectStrlen(){
+    const CpuFeatures& cpu = cpuFeatures();
+    if(cpu.avx2) return myStrlenAvx2;
+    if(cpu.sse2) return myStrlenSse2;
+    return myStrlenSwar;
+}
+
+static StrCompareFn selectStrCompare(){
+    const CpuFeatures& cpu = cpuFeatures();
+    if(cpu.avx2) return myStrCompareAvx2;
+    if(cpu.sse2) return myStrCompareSse2;
+    return myStrCompareSwar;
+}
+
+static size_t resolveStrlen(const char* str);
+static int resolveStrCompare(const char* str1, const char* str2);
+
+static std::atomic<StrlenFn> strlenImpl{resolveStrlen};
+static std::atomic<StrCompareFn> strCompareImpl{resolveStrCompare};
+
+static size_t resolveStrlen(const char* str){
+    StrlenFn best = selectStrlen();
+    strlenImpl.store(best, std::memory_order_relaxed);
+    return best(str);
+}
+
+static int resolveStrCompare(const char* str1, const char* str2){
+    StrCompareFn best = selectStrCompare();
+    strCompareImpl.store(best, std::memory_order_relaxed);
+    return best(str1, str2);
+}
+
+size_t myStrlenRuntime(const char* str){
+    return strlenImpl.load(std::memory_order_relaxed)(str);
+}
+
+int myStrCompareRuntime(const char* str1, const char* str2){
+    return strCompareImpl.load(std::memory_order_relaxed)(str1, str2);
+}
+
+const char* myStrlenKernelName(){
+    StrlenFn best = selectStrlen();
+    if(best == myStrlenAvx2) return "avx2";
+    if(best == myStrlenSse2) return "sse2";
+    if(best == myStrlenSwar) return "swar";
+    return "scalar";
+}
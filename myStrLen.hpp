@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+
+/*
+C-string primitives.
+myStrlen and myStrCompare are dispatched at runtime to the fastest kernel the CPU supports (see myStrLen.cpp).
+The Scalar versions are the original byte-at-a-time loops: they are the portable fallback and the test oracle
+that every vector kernel must agree with.
+*/
+
+// Runtime entry points: the kernels chosen by the dispatcher
+size_t myStrlenRuntime(const char* str);
+int myStrCompareRuntime(const char* str1, const char* str2);
+
+/*
+The public functions are constexpr, so they also work in constant expressions (static tables, static_assert,
+FixedString in String/FixedString.hpp):
+    static_assert(myStrlen("GET") == 3);
+During constant evaluation they run a plain loop; at runtime std::is_constant_evaluated() is false and the call goes
+to the vector kernel, so runtime callers pay nothing for the constexpr support.
+*/
+constexpr size_t myStrlen(const char* str){
+    if(std::is_constant_evaluated()){
+        size_t length = 0;
+        while(str[length] != '\0') length++;
+        return length;
+    }
+    return myStrlenRuntime(str);
+}
+
+// Three-way: <0, 0 or >0 like strcmp (bytes compared as unsigned char)
+constexpr int myStrCompare(const char* str1, const char* str2){
+    if(std::is_constant_evaluated()){
+        while(*str1 != '\0' && *str1 == *str2){
+            str1++;
+            str2++;
+        }
+        return static_cast<unsigned char>(*str1) - static_cast<unsigned char>(*str2);
+    }
+    return myStrCompareRuntime(str1, str2);
+}
+
+// Equality only: true when both strings are equal
+constexpr bool myStrCmp(const char* str1, const char* str2){
+    return myStrCompare(str1, str2) == 0; // Same kernel drives equality and ordering
+}
+
+constexpr char* myStrCpy(char* dest, const char* src){
+    char* d = dest;
+    while(*src!= '\0'){
+        *d = *src; // Copy each character from source to destination
+        d++;
+        src++;
+    }
+    *d = '\0'; // Add null terminator at the end of the destination string
+    return dest; // Return the destination pointer
+}
+
+// Individual kernels, exposed for tests and benchmarks. AVX2/SSE2 kernels must only be called when the CPU supports them.
+size_t myStrlenScalar(const char* str);
+size_t myStrlenSwar(const char* str);
+size_t myStrlenSse2(const char* str);
+size_t myStrlenAvx2(const char* str);
+
+int myStrCompareScalar(const char* str1, const char* str2);
+int myStrCompareSwar(const char* str1, const char* str2);
+int myStrCompareSse2(const char* str1, const char* str2);
+int myStrCompareAvx2(const char* str1, const char* str2);
+
+// Name of the kernel selected by the dispatcher ("avx2", "sse2", "swar" or "scalar")
+const char* myStrlenKernelName();
@@ -0,0 +1,110 @@
+/*
+Demo and self-check for the C-string primitives in myStrLen.cpp.
+Build: g++ -std=c++20 -O2 myStrLenDemo.cpp myStrLen.cpp -o myStrLenDemo
+*/
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "myStrLen.hpp"
+#include "cpuFeatures.hpp"
+using namespace std;
+
+static int sign(int value){
+    return (value > 0) - (value < 0);
+}
+
+/*
+Every kernel is checked against the scalar oracle for all lengths 0..300 at all 64 start offsets.
+The page-boundary check places the null-terminator on the last byte before a PROT_NONE guard page: a kernel that
+reads across the page boundary crashes with SIGSEGV here.
+*/
+static bool checkKernels(){
+    const CpuFeatures& cpu = cpuFeatures();
+    size_t (*strlenKernels[])(const char*) = {myStrlenScalar, myStrlenSwar, cpu.sse2 ? myStrlenSse2 : myStrlenSwar, cpu.avx2 ? myStrlenAvx2 : myStrlenSwar, myStrlen};
+    int (*compareKernels[])(const char*, const char*) = {myStrCompareScalar, myStrCompareSwar, cpu.sse2 ? myStrCompareSse2 : myStrCompareSwar, cpu.avx2 ? myStrCompareAvx2 : myStrCompareSwar, myStrCompare};
+
+    bool ok = true;
+    mt19937 rng(42);
+    string buffer(512, '\0');
+    string other(512, '\0');
+    for(size_t offset = 0; offset < 64; offset++){
+        for(size_t len = 0; len < 300; len++){
+            for(size_t i = 0; i < len; i++) buffer[offset + i] = static_cast<char>('a' + rng() % 26);
+            buffer[offset + len] = '\0';
+            const char* s = buffer.data() + offset;
+            for(auto kernel : strlenKernels){
+                if(kernel(s) != len){ cout << "strlen mismatch at offset " << offset << " len " << len << "\n"; ok = false; }
+            }
+            // Compare against a copy at a different alignment with one byte changed (or none)
+            size_t otherOffset = (offset * 7) % 64;
+            memcpy(&other[otherOffset], s, len + 1);
+            if(len > 0 && rng() % 2) other[otherOffset + rng() % len] = static_cast<char>(rng() % 2 ? 'A' : '\xF0');
+            const char* t = other.data() + otherOffset;
+            int expected = sign(myStrCompareScalar(s, t));
+            for(auto kernel : compareKernels){
+                if(sign(kernel(s, t)) != expected || sign(kernel(t, s)) != -expected){ cout << "compare mismatch at offset " << offset << " len " << len << "\n"; ok = false; }
+            }
+        }
+    }
+
+    long page = sysconf(_SC_PAGESIZE);
+    char* mapping = static_cast<char*>(mmap(nullptr, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if(mapping != MAP_FAILED){
+        mprotect(mapping + page, page, PROT_NONE); // Guard page right after the string
+        for(size_t len = 0; len < 100; len++){
+            char* s = mapping + page - len - 1;
+            memset(s, 'x', len);
+            s[len] = '\0';
+            for(auto kernel : strlenKernels){
+                if(kernel(s) != len){ cout << "strlen mismatch before guard page, len " << len << "\n"; ok = false; }
+            }
+            for(auto kernel : compareKernels){
+                if(kernel(s, s) != 0){ cout << "compare mismatch before guard page, len " << len << "\n"; ok = false; }
+            }
+        }
+        munmap(mapping, 2 * page);
+    }
+    return ok;
+}
+
+template <typename Fn>
+static double nsPerCall(Fn fn, size_t iterations){
+    auto start = chrono::steady_clock::now();
+    for(size_t i = 0; i < iterations; i++) fn();
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / iterations;
+}
+
+int main() {
+
+    cout <<"Length of \"Hello\" : " << myStrlen("Hello") <<"\n";
+    string s = "Hello World";
+    cout <<"Length of s : " << myStrlen(s.c_str()) << "\n";
+    const char * s2 = "Shreya Garg";
+    cout <<"Length of s2 : " << myStrlen(s2) << "\n";
+    char s3[20] = "Learning";
+    cout <<"Length of s3 : "<<myStrlen(s3) << "\n";
+
+    myStrCpy(s3, "Programming");
+    cout <<"s3 after copying \"Programming\" : " << s3 << "\n";
+
+    myStrCmp("Hello", "Hello") ? cout << "\"Hello\" and \"Hello\" are equal\n" : cout << "\"Hello\" and \"Hello\" are not equal\n";
+    myStrCmp("Hello", "World") ? cout << "\"Hello\" and \"World\" are equal\n" : cout << "\"Hello\" and \"World\" are not equal\n";
+    myStrCmp("Hello", "HelloWorld") ? cout << "\"Hello\" and \"HelloWorld\" are equal\n" : cout << "\"Hello\" and \"HelloWorld\" are not equal\n";
+    cout << "myStrCompare(\"apple\", \"banana\") : " << myStrCompare("apple", "banana") << "\n";
+
+    cout << "\nSelected kernel: " << myStrlenKernelName() << "\n";
+    cout << "Kernels agree with scalar oracle: " << (checkKernels() ? "yes" : "NO") << "\n";
+
+    string line(4096, 'x');
+    volatile size_t sink = 0;
+    const char* text = line.c_str();
+    cout << "strlen of 4 KiB string (ns/call): scalar " << nsPerCall([&]{ sink = sink + myStrlenScalar(text); }, 100000)
+         << ", myStrlen " << nsPerCall([&]{ sink = sink + myStrlen(text); }, 100000)
+         << ", libc " << nsPerCall([&]{ sink = sink + strlen(text); }, 100000) << "\n";
+
+    return 0;
+}
@@ -1,20 +1,33 @@
 #include <iostream>
 #include <cstring>
+#include "instrumentation.hpp"
+#include "myMemOps.hpp"
 using namespace std;
 
 class myString{
     public :
-        myString(): str(nullptr), length(0) {} // Default constructor - Empty string initialization
+        myString(): str(nullptr), length(0) { // Default constructor - Empty string initialization
+            INSTRUMENT_COUNT(MyStringConstructions);
+        }
         myString(const char* s) : str(new char[strlen(s) + 1]), length(strlen(s)) { // Parameterized constructor
+            INSTRUMENT_COUNT(MyStringConstructions);
+            INSTRUMENT_COUNT(MyStringHeapAllocations);
+            INSTRUMENT_ADD(MyStringHeapBytes, length + 1);
             strcpy(str, s); // Copy the input string to the member variable
         }   
 
         myString(const myString& other) : str(new char[other.length + 1]), length(other.length) { // Copy constructor
+            INSTRUMENT_COPY(MyStringCopyConstructions, length);
+            INSTRUMENT_COUNT(MyStringHeapAllocations);
+            INSTRUMENT_ADD(MyStringHeapBytes, length + 1);
             strcpy(str, other.str); // Copy the string from the other object
         }
 
         myString& operator=(const myString& other){
             if(this != &other){ // check for self-assignment because if we assign an object to itself, we dont want to delete the memory of the object before copying it. This would lead to undefined behavior and potential crashes. 
+                INSTRUMENT_COPY(MyStringCopyAssignments, other.length);
+                INSTRUMENT_COUNT(MyStringHeapAllocations);
+                INSTRUMENT_ADD(MyStringHeapBytes, other.length + 1);
                 delete[] str; // Free the existing memory(Since this is copy assignment operator, we need to free the existing memory of the object before copying the new data from the other object. This is to avoid memory leaks and ensure that we are not holding onto memory that is no longer needed.)
                 length = other.length; // Copy the length from the other object
                 str = new char[length + 1]; // Allocate new memory for the string
@@ -24,10 +37,10 @@ class myString{
         }
 
         bool operator==(const myString& other) const{
-            return strcmp(str,other.str) == 0; // Compare the strings using strcmp
+            return length == other.length && myMemCmp(str, other.str, length) == 0; // Different lengths can never be equal; otherwise one vectorized compare (and no strcmp on a null default-constructed str)
         }
         friend ostream& operator<<(ostream& os, const myString& s){//Declared as friend function so that it can access the private members of the class. This allows us to directly access the 'str' member variable of the 'myString' class and output its value to the output stream.
-            os << s.str; // Output the string to the output stream
+            os.write(s.str, static_cast<streamsize>(s.length)); // Output the string to the output stream: the length is known, so no strlen (and a moved-from nullptr is fine)
             return os;
         }
     private :
@@ -0,0 +1,470 @@
+#include "myUtf8.hpp"
+#include "cpuFeatures.hpp"
+#include <atomic>
+#include <cstring>
+
+static inline uint64_t read64(const char* p){
+    uint64_t value;
+    std::memcpy(&value, p, 8);
+    return value;
+}
+
+static constexpr uint64_t highBits = 0x8080808080808080ULL;
+
+/*
+Decodes one code point starting at p (p[0] >= 0x80) and returns its length in bytes, or 0 if the sequence is
+malformed. The second byte of E0/ED/F0/F4 sequences has a narrower range: that is what rules out overlong 3/4-byte
+forms, UTF-16 surrogates (U+D800..U+DFFF) and values above U+10FFFF. C0, C1 and F5..FF never appear in UTF-8.
+*/
+static size_t decodeMultibyte(const unsigned char* p, size_t remaining, char32_t* codePoint){
+    unsigned char lead = p[0];
+    auto isContinuation = [](unsigned char byte){ return (byte & 0xC0) == 0x80; };
+    if(lead < 0xC2){
+        return 0;
+    }
+    if(lead < 0xE0){
+        if(remaining < 2 || !isContinuation(p[1])) return 0;
+        *codePoint = (char32_t(lead & 0x1F) << 6) | (p[1] & 0x3F);
+        return 2;
+    }
+    if(lead < 0xF0){
+        if(remaining < 3 || !isContinuation(p[1]) || !isContinuation(p[2])) return 0;
+        if((lead == 0xE0 && p[1] < 0xA0) || (lead == 0xED && p[1] > 0x9F)) return 0;
+        *codePoint = (char32_t(lead & 0x0F) << 12) | (char32_t(p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+        return 3;
+    }
+    if(lead < 0xF5){
+        if(remaining < 4 || !isContinuation(p[1]) || !isContinuation(p[2]) || !isContinuation(p[3])) return 0;
+        if((lead == 0xF0 && p[1] < 0x90) || (lead == 0xF4 && p[1] > 0x8F)) return 0;
+        *codePoint = (char32_t(lead & 0x07) << 18) | (char32_t(p[1] & 0x3F) << 12) | (char32_t(p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+        return 4;
+    }
+    return 0;
+}
+
+// Encodes a scalar value (not a surrogate, <= U+10FFFF) and returns the number of bytes written
+static inline size_t encodeUtf8(char32_t codePoint, char* out){
+    if(codePoint < 0x80){
+        out[0] = static_cast<char>(codePoint);
+        return 1;
+    }
+    if(codePoint < 0x800){
+        out[0] = static_cast<char>(0xC0 | (codePoint >> 6));
+        out[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        return 2;
+    }
+    if(codePoint < 0x10000){
+        out[0] = static_cast<char>(0xE0 | (codePoint >> 12));
+        out[1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | (codePoint >> 18));
+    out[1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+    return 4;
+}
+
+/* Scalar kernels: 8 bytes at a time while the text is ASCII */
+
+static bool isAsciiScalar(const char* text, size_t n){
+    size_t i = 0;
+    uint64_t seen = 0;
+    for(; i + 8 <= n; i += 8){
+        seen |= read64(text + i);
+    }
+    for(; i < n; i++){
+        seen |= static_cast<unsigned char>(text[i]);
+    }
+    return (seen & highBits) == 0;
+}
+
+static bool validateScalar(const char* text, size_t n){
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text);
+    size_t i = 0;
+    while(i < n){
+        if(i + 8 <= n && (read64(text + i) & highBits) == 0){
+            i += 8;
+            continue;
+        }
+        if(p[i] < 0x80){
+            i++;
+            continue;
+        }
+        char32_t codePoint;
+        size_t length = decodeMultibyte(p + i, n - i, &codePoint);
+        if(length == 0){
+            return false;
+        }
+        i += length;
+    }
+    return true;
+}
+
+static size_t countScalar(const char* text, size_t n){
+    size_t count = 0;
+    for(size_t i = 0; i < n; i++){
+        count += (static_cast<unsigned char>(text[i]) & 0xC0) != 0x80;
+    }
+    return count;
+}
+
+#if SIMD_X86
+static bool isAsciiSse2(const char* text, size_t n){
+    size_t i = 0;
+    __m128i seen = _mm_setzero_si128();
+    for(; i + 16 <= n; i += 16){
+        seen = _mm_or_si128(seen, _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i)));
+    }
+    return _mm_movemask_epi8(seen) == 0 && isAsciiScalar(text + i, n - i);
+}
+
+/*
+Continuation bytes are 0x80..0xBF, i.e. -128..-65 as signed bytes, so "lead byte" is a single signed compare.
+The 0/-1 compare results are subtracted into byte counters, which are widened with psadbw before they can overflow.
+*/
+static size_t countSse2(const char* text, size_t n){
+    const __m128i lastContinuation = _mm_set1_epi8(-65);
+    size_t i = 0, count = 0;
+    while(i + 16 <= n){
+        __m128i counters = _mm_setzero_si128();
+        for(size_t rounds = 0; rounds < 255 && i + 16 <= n; rounds++, i += 16){
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+            counters = _mm_sub_epi8(counters, _mm_cmpgt_epi8(block, lastContinuation));
+        }
+        __m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+        count += static_cast<size_t>(_mm_cvtsi128_si64(sums)) + static_cast<size_t>(_mm_extract_epi16(sums, 4));
+    }
+    return count + countScalar(text + i, n - i);
+}
+
+TARGET_AVX2 static bool isAsciiAvx2(const char* text, size_t n){
+    size_t i = 0;
+    __m256i seen = _mm256_setzero_si256();
+    for(; i + 32 <= n; i += 32){
+        seen = _mm256_or_si256(seen, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i)));
+    }
+    return _mm256_movemask_epi8(seen) == 0 && isAsciiScalar(text + i, n - i);
+}
+
+TARGET_AVX2 static size_t countAvx2(const char* text, size_t n){
+    const __m256i lastContinuation = _mm256_set1_epi8(-65);
+    size_t i = 0, count = 0;
+    while(i + 32 <= n){
+        __m256i counters = _mm256_setzero_si256();
+        for(size_t rounds = 0; rounds < 255 && i + 32 <= n; rounds++, i += 32){
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+            counters = _mm256_sub_epi8(counters, _mm256_cmpgt_epi8(block, lastContinuation));
+        }
+        __m256i sums = _mm256_sad_epu8(counters, _mm256_setzero_si256());
+        count += static_cast<size_t>(_mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1)
+                                     + _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3));
+    }
+    return count + countScalar(text + i, n - i);
+}
+
+/*
+Keiser-Lemire lookup validation, 32 bytes per step.
+Each error class is one bit; a byte pair is invalid when the three table lookups (high nibble of the previous byte,
+low nibble of the previous byte, high nibble of the current byte) have a bit in common.
+twoConts (a continuation after a continuation) is the only "error" that can be legitimate: it is expected exactly
+where the byte 2 or 3 positions back was a 3- or 4-byte lead, and that expectation is xored out.
+*/
+static constexpr uint8_t tooShort = 1 << 0;    // lead byte followed by a lead/ASCII byte
+static constexpr uint8_t tooLong = 1 << 1;     // ASCII followed by a continuation
+static constexpr uint8_t overlong3 = 1 << 2;   // E0 80..9F
+static constexpr uint8_t tooLarge = 1 << 3;    // F4 90..BF, F5..FF
+static constexpr uint8_t surrogate = 1 << 4;   // ED A0..BF
+static constexpr uint8_t overlong2 = 1 << 5;   // C0, C1
+static constexpr uint8_t tooLarge1000 = 1 << 6; // F5..FF followed by 80..8F
+static constexpr uint8_t overlong4 = 1 << 6;   // F0 80..8F
+static constexpr uint8_t twoConts = 1 << 7;    // continuation after continuation
+static constexpr uint8_t carry = tooShort | tooLong | twoConts;
+
+TARGET_AVX2 static inline __m256i table16(uint8_t e0, uint8_t e1, uint8_t e2, uint8_t e3, uint8_t e4, uint8_t e5,
+                                          uint8_t e6, uint8_t e7, uint8_t e8, uint8_t e9, uint8_t e10, uint8_t e11,
+                                          uint8_t e12, uint8_t e13, uint8_t e14, uint8_t e15){
+    return _mm256_setr_epi8(e0, e1, e2, e3, e4, e5, e6, e7, e8, e9, e10, e11, e12, e13, e14, e15,
+                            e0, e1, e2, e3, e4, e5, e6, e7, e8, e9, e10, e11, e12, e13, e14, e15);
+}
+
+// The 32 bytes ending N bytes before the end of input: the last N bytes of previous followed by input
+template <int N>
+TARGET_AVX2 static inline __m256i previousBytes(__m256i input, __m256i previous){
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - N);
+}
+
+struct Utf8Tables {
+    __m256i byte1High, byte1Low, byte2High, nibbleMask, incompleteLimit;
+};
+
+TARGET_AVX2 static inline __m256i blockErrors(__m256i input, __m256i previous, const Utf8Tables& t){
+    __m256i prev1 = previousBytes<1>(input, previous);
+    __m256i high1 = _mm256_and_si256(_mm256_srli_epi16(prev1, 4), t.nibbleMask);
+    __m256i low1 = _mm256_and_si256(prev1, t.nibbleMask);
+    __m256i high2 = _mm256_and_si256(_mm256_srli_epi16(input, 4), t.nibbleMask);
+    __m256i special = _mm256_and_si256(_mm256_and_si256(_mm256_shuffle_epi8(t.byte1High, high1),
+                                                        _mm256_shuffle_epi8(t.byte1Low, low1)),
+                                       _mm256_shuffle_epi8(t.byte2High, high2));
+    // 3rd/4th bytes of a sequence: the byte 2 back is >= E0 or the byte 3 back is >= F0
+    __m256i third = _mm256_subs_epu8(previousBytes<2>(input, previous), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    __m256i fourth = _mm256_subs_epu8(previousBytes<3>(input, previous), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    __m256i expected = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+    return _mm256_xor_si256(expected, special);
+}
+
+struct ValidationState {
+    __m256i errors;             // error bits accumulated so far
+    __m256i previous;           // the previous block, for the bytes that straddle the boundary
+    __m256i previousIncomplete; // non-zero if the previous non-ASCII block ended inside a sequence
+};
+
+TARGET_AVX2 static inline void validateBlock(ValidationState& state, __m256i input, const Utf8Tables& t){
+    if(_mm256_movemask_epi8(input) == 0){
+        // ASCII block: only a sequence left open by the previous block can be wrong
+        state.errors = _mm256_or_si256(state.errors, state.previousIncomplete);
+    }
+    else{
+        state.errors = _mm256_or_si256(state.errors, blockErrors(input, state.previous, t));
+        state.previousIncomplete = _mm256_subs_epu8(input, t.incompleteLimit);
+    }
+    state.previous = input;
+}
+
+TARGET_AVX2 static bool validateAvx2(const char* text, size_t n){
+    const Utf8Tables t = {
+        table16(tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, tooLong,
+                twoConts, twoConts, twoConts, twoConts,
+                tooShort | overlong2, tooShort, tooShort | overlong3 | surrogate, tooShort | tooLarge | tooLarge1000 | overlong4),
+        table16(carry | overlong3 | overlong2 | overlong4, carry | overlong2, carry, carry,
+                carry | tooLarge, carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000 | surrogate, carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000),
+        table16(tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, tooShort,
+                tooLong | overlong2 | twoConts | overlong3 | tooLarge1000 | overlong4,
+                tooLong | overlong2 | twoConts | overlong3 | tooLarge,
+                tooLong | overlong2 | twoConts | surrogate | tooLarge,
+                tooLong | overlong2 | twoConts | surrogate | tooLarge,
+                tooShort, tooShort, tooShort, tooShort),
+        _mm256_set1_epi8(0x0F),
+        // A block may not end inside a sequence: last byte >= C0, second to last >= E0, third to last >= F0
+        _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                         static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1)),
+    };
+    ValidationState state = {_mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256()};
+    size_t i = 0;
+    for(; i + 32 <= n; i += 32){
+        validateBlock(state, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i)), t);
+        if((i & 1023) == 992 && !_mm256_testz_si256(state.errors, state.errors)){
+            return false; // early out every 1 KiB
+        }
+    }
+    // The tail is padded with zero bytes (ASCII), which also reports a sequence cut off by the end of the text
+    alignas(32) char tail[32] = {};
+    std::memcpy(tail, text + i, n - i);
+    validateBlock(state, _mm256_load_si256(reinterpret_cast<const __m256i*>(tail)), t);
+    __m256i errors = _mm256_or_si256(state.errors, state.previousIncomplete);
+    return _mm256_testz_si256(errors, errors);
+}
+#endif
+
+struct Utf8Kernels {
+    bool (*isAscii)(const char*, size_t);
+    size_t (*count)(const char*, size_t);
+    bool (*validate)(const char*, size_t);
+    const char* name;
+};
+
+static const Utf8Kernels scalarKernels = {isAsciiScalar, countScalar, validateScalar, "scalar"};
+#if SIMD_X86
+// SSE2 has no byte shuffle (pshufb is SSSE3), so SSE2-only machines validate with the scalar decoder
+static const Utf8Kernels sse2Kernels = {isAsciiSse2, countSse2, validateScalar, "scalar"};
+static const Utf8Kernels avx2Kernels = {isAsciiAvx2, countAvx2, validateAvx2, "avx2"};
+#endif
+
+static const Utf8Kernels* selectUtf8Kernels(){
+#if SIMD_X86
+    const CpuFeatures& cpu = cpuFeatures();
+    if(cpu.avx2) return &avx2Kernels;
+    if(cpu.sse2) return &sse2Kernels;
+#endif
+    return &scalarKernels;
+}
+
+static std::atomic<const Utf8Kernels*> activeUtf8Kernels{nullptr};
+
+static const Utf8Kernels* utf8Kernels(){
+    const Utf8Kernels* kernels = activeUtf8Kernels.load(std::memory_order_relaxed);
+    if(!kernels){
+        kernels = selectUtf8Kernels();
+        activeUtf8Kernels.store(kernels, std::memory_order_relaxed);
+    }
+    return kernels;
+}
+
+bool myIsAscii(const char* text, size_t n){
+    return utf8Kernels()->isAscii(text, n);
+}
+
+bool myUtf8Validate(const char* text, size_t n){
+    return utf8Kernels()->validate(text, n);
+}
+
+size_t myUtf8CountCodePoints(const char* text, size_t n){
+    return utf8Kernels()->count(text, n);
+}
+
+const char* myUtf8KernelName(){
+    return utf8Kernels()->name;
+}
+
+/*
+Transcoding. Text is mostly ASCII, so at an ASCII unit each loop first tries to convert a whole 16-byte (8-unit) block
+with SSE2, which is part of the x86-64 baseline and needs no dispatch; otherwise the scalar code converts one code
+point.
+*/
+
+size_t myUtf8ToUtf16(const char* src, size_t n, char16_t* dst){
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(src);
+    char16_t* out = dst;
+    size_t i = 0;
+    while(i < n){
+#ifdef __SSE2__
+        if(i + 16 <= n && p[i] < 0x80){
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            if(_mm_movemask_epi8(block) == 0){
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(block, _mm_setzero_si128()));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpackhi_epi8(block, _mm_setzero_si128()));
+                i += 16;
+                out += 16;
+                continue;
+            }
+        }
+#endif
+        if(p[i] < 0x80){
+            *out++ = p[i++];
+            continue;
+        }
+        char32_t codePoint;
+        size_t length = decodeMultibyte(p + i, n - i, &codePoint);
+        if(length == 0){
+            return myUtfError;
+        }
+        if(codePoint >= 0x10000){
+            codePoint -= 0x10000;
+            *out++ = static_cast<char16_t>(0xD800 | (codePoint >> 10));
+            *out++ = static_cast<char16_t>(0xDC00 | (codePoint & 0x3FF));
+        }
+        else{
+            *out++ = static_cast<char16_t>(codePoint);
+        }
+        i += length;
+    }
+    return static_cast<size_t>(out - dst);
+}
+
+size_t myUtf8ToUtf32(const char* src, size_t n, char32_t* dst){
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(src);
+    char32_t* out = dst;
+    size_t i = 0;
+    while(i < n){
+#ifdef __SSE2__
+        if(i + 16 <= n && p[i] < 0x80){
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            if(_mm_movemask_epi8(block) == 0){
+                __m128i zero = _mm_setzero_si128();
+                __m128i low = _mm_unpacklo_epi8(block, zero), high = _mm_unpackhi_epi8(block, zero);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi16(low, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpackhi_epi16(low, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpacklo_epi16(high, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi16(high, zero));
+                i += 16;
+                out += 16;
+                continue;
+            }
+        }
+#endif
+        if(p[i] < 0x80){
+            *out++ = p[i++];
+            continue;
+        }
+        size_t length = decodeMultibyte(p + i, n - i, out);
+        if(length == 0){
+            return myUtfError;
+        }
+        out++;
+        i += length;
+    }
+    return static_cast<size_t>(out - dst);
+}
+
+size_t myUtf16ToUtf8(const char16_t* src, size_t n, char* dst){
+    char* out = dst;
+    size_t i = 0;
+    while(i < n){
+#ifdef __SSE2__
+        if(i + 8 <= n && src[i] < 0x80){
+            __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            // All 8 units < 0x80: no bit set outside the low 7 bits of any unit
+            if(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xFF80))), _mm_setzero_si128())) == 0xFFFF){
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(units, units));
+                i += 8;
+                out += 8;
+                continue;
+            }
+        }
+#endif
+        char32_t unit = src[i];
+        if(unit >= 0xD800 && unit <= 0xDFFF){
+            // A high surrogate must be followed by a low surrogate; a lone low surrogate is never valid
+            if(unit > 0xDBFF || i + 1 == n || src[i + 1] < 0xDC00 || src[i + 1] > 0xDFFF){
+                return myUtfError;
+            }
+            char32_t codePoint = 0x10000 + ((unit - 0xD800) << 10) + (src[i + 1] - 0xDC00);
+            out += encodeUtf8(codePoint, out);
+            i += 2;
+            continue;
+        }
+        out += encodeUtf8(unit, out);
+        i++;
+    }
+    return static_cast<size_t>(out - dst);
+}
+
+size_t myUtf32ToUtf8(const char32_t* src, size_t n, char* dst){
+    char* out = dst;
+    for(size_t i = 0; i < n; i++){
+        char32_t codePoint = src[i];
+        if(codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)){
+            return myUtfError;
+        }
+        out += encodeUtf8(codePoint, out);
+    }
+    return static_cast<size_t>(out - dst);
+}
+
+size_t myUtf8LengthFromUtf16(const char16_t* src, size_t n){
+    size_t length = 0;
+    for(size_t i = 0; i < n; i++){
+        char16_t unit = src[i];
+        if(unit < 0x80) length += 1;
+        else if(unit < 0x800) length += 2;
+        else if(unit >= 0xD800 && unit <= 0xDBFF && i + 1 < n && src[i + 1] >= 0xDC00 && src[i + 1] <= 0xDFFF){
+            length += 4; // surrogate pair
+            i++;
+        }
+        else length += 3;
+    }
+    return length;
+}
+
+size_t myUtf8LengthFromUtf32(const char32_t* src, size_t n){
+    size_t length = 0;
+    for(size_t i = 0; i < n; i++){
+        char32_t codePoint = src[i];
+        length += codePoint < 0x80 ? 1 : codePoint < 0x800 ? 2 : codePoint < 0x10000 ? 3 : 4;
+    }
+    return length;
+}
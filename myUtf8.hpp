@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/*
+UTF-8 primitives (used by String::isValidUtf8, codePointCount, toUtf16/toUtf32 and fromUtf16/fromUtf32).
+
+myUtf8Validate is the lookup algorithm of Keiser & Lemire ("Validating UTF-8 in less than one instruction per byte",
+2021; the simdjson validator): every error is a property of at most two consecutive bytes, except the number of
+continuation bytes, so three 16-entry tables indexed by the nibbles of each byte pair (three pshufb lookups ANDed
+together) flag overlong encodings, surrogates, values above U+10FFFF and stray or missing continuations, and the
+expected 3rd/4th continuation bytes are checked with two shifted compares. Pure-ASCII blocks skip all of it.
+The AVX2 kernel is chosen at runtime; the scalar kernel decodes sequence by sequence.
+
+Byte counts and code point counts are size_t; the transcoders return the number of units written, or myUtfError for
+malformed input (nothing is written past the first malformed sequence).
+*/
+static constexpr size_t myUtfError = static_cast<size_t>(-1);
+
+// true if every byte is < 0x80 (then the text is valid UTF-8 and has exactly n code points)
+bool myIsAscii(const char* text, size_t n);
+
+// true if text is well-formed UTF-8 (no overlongs, surrogates, values above U+10FFFF or truncated sequences)
+bool myUtf8Validate(const char* text, size_t n);
+
+// Number of bytes that are not continuation bytes (10xxxxxx): the code point count of valid UTF-8
+size_t myUtf8CountCodePoints(const char* text, size_t n);
+
+/*
+Transcoding. The destination must have room for the worst case:
+    UTF-8  -> UTF-16 / UTF-32 : n units (every code point takes at least as many UTF-8 bytes as units)
+    UTF-16 -> UTF-8           : myUtf8LengthFromUtf16(src, n) bytes (at most 3 * n)
+    UTF-32 -> UTF-8           : myUtf8LengthFromUtf32(src, n) bytes (at most 4 * n)
+Runs of ASCII are widened/narrowed 16 bytes at a time.
+*/
+size_t myUtf8ToUtf16(const char* src, size_t n, char16_t* dst);
+size_t myUtf8ToUtf32(const char* src, size_t n, char32_t* dst);
+size_t myUtf16ToUtf8(const char16_t* src, size_t n, char* dst);
+size_t myUtf32ToUtf8(const char32_t* src, size_t n, char* dst);
+
+// Exact UTF-8 size of well-formed input (an upper bound for malformed input, which the transcoders reject)
+size_t myUtf8LengthFromUtf16(const char16_t* src, size_t n);
+size_t myUtf8LengthFromUtf32(const char32_t* src, size_t n);
+
+// Name of the validation kernel selected at runtime ("avx2" or "scalar")
+const char* myUtf8KernelName();